@@ -2,18 +2,32 @@
 #include "esphome/components/i2c/i2c_bus.h"
 #include "bm8563.h"
 
+#include <algorithm>
+
+#ifdef USE_ESP32
+#include <esp_sleep.h>
+#endif
+
 namespace esphome {
 namespace bm8563 {
 
 static const char *TAG = "bm8563.sensor";
 
 void BM8563::setup(){
+  // Before the flags are cleared below
+  this->wake_reason_ = this->readWakeReason();
+  ESP_LOGI(TAG, "Wake reason: %s", this->get_wake_reason_name());
+  if (this->wake_reason_text_sensor_ != nullptr) {
+    this->wake_reason_text_sensor_->publish_state(this->get_wake_reason_name());
+  }
   this->write_byte_16(0,0);
   this->setupComplete = true;
+  // Boot and deep sleep wake both come through here
+  this->read_time();
 }
 
 void BM8563::update(){
-  if(!this->setupComplete){
+  if(!this->setupComplete || this->sync_policy_ != BM8563_SYNC_INTERVAL){
      return;
   }
   this->read_time();
@@ -23,6 +37,8 @@ void BM8563::dump_config(){
   ESP_LOGCONFIG(TAG, "BM8563:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "  setupComplete: %s", this->setupComplete ? "true" : "false");
+  ESP_LOGCONFIG(TAG, "  Sync Policy: %s", this->sync_policy_ == BM8563_SYNC_INTERVAL ? "interval" : "boot");
+  ESP_LOGCONFIG(TAG, "  Wake Reason: %s", this->get_wake_reason_name());
   if (this->sleep_duration_.has_value()) {
     uint32_t duration = *this->sleep_duration_;
     ESP_LOGCONFIG(TAG, "  Sleep Duration: %u ms", duration);
@@ -34,11 +50,55 @@ void BM8563::set_sleep_duration(uint32_t time_s) {
   this->sleep_duration_ = time_s;
 }
 
-void BM8563::apply_sleep_duration() {
-  if (this->sleep_duration_.has_value() && this->setupComplete) {
-    this->clearIRQ();
-    this->SetAlarmIRQ(*this->sleep_duration_);
+int BM8563::apply_sleep_duration() {
+  if (!this->sleep_duration_.has_value()) {
+    return -1;
+  }
+  return this->apply_countdown(*this->sleep_duration_ / 1000);
+}
+
+int BM8563::apply_countdown(uint32_t seconds) {
+  if (!this->setupComplete) {
+    return -1;
+  }
+  this->clearIRQ();
+  return this->SetAlarmIRQ(int(std::min<uint32_t>(seconds, 255 * 60)));
+}
+
+int BM8563::apply_alarm_at(int hour, int minute) {
+  auto now = time::RealTimeClock::now();
+  if (!now.is_valid() || minute < 0 || minute > 59 || hour > 23) {
+    ESP_LOGE(TAG, "No valid time or alarm %i:%02i, alarm not set", hour, minute);
+    return -1;
+  }
+  // Seconds from now to second 0 of the target minute, in local time
+  const int now_s = now.minute * 60 + now.second;
+  int delta;
+  if (hour < 0) {
+    delta = minute * 60 - now_s;
+    if (delta <= 0) {
+      delta += 3600;
+    }
+  } else {
+    delta = (hour * 60 + minute) * 60 - (now.hour * 3600 + now_s);
+    if (delta <= 0) {
+      delta += 86400;
+    }
+  }
+  return this->setAlarmAtEpoch(now.timestamp + delta);
+}
+
+int BM8563::apply_alarm_every(uint32_t minutes) {
+  auto now = time::RealTimeClock::now();
+  if (!now.is_valid() || minutes == 0) {
+    ESP_LOGE(TAG, "No valid time, alarm not set");
+    return -1;
   }
+  // Counted from local midnight, so a period that does not divide the day still restarts at 00:00
+  const uint32_t minute_of_day = now.hour * 60 + now.minute;
+  const uint32_t next = std::min<uint32_t>((minute_of_day / minutes + 1) * minutes, 24 * 60);
+  const int delta = int(next - minute_of_day) * 60 - now.second;
+  return this->setAlarmAtEpoch(now.timestamp + delta);
 }
 
 void BM8563::write_time() {
@@ -54,24 +114,26 @@ void BM8563::write_time() {
     seconds: int8_t(now.second),
   };
 
+  // ESPTime counts weekdays 1-7 from Sunday, the RTC 0-6
   BM8563_DateTypeDef BM8563_DateStruct = {
     day: int8_t(now.day_of_month),
-    week: int8_t(now.day_of_week),
+    week: int8_t(now.day_of_week - 1),
     month: int8_t(now.month),
     year: int16_t(now.year)
   };
 
-  this->setTime(&BM8563_TimeStruct);
-  this->setDate(&BM8563_DateStruct);
+  if (!this->setDateTime(&BM8563_TimeStruct, &BM8563_DateStruct)) {
+    ESP_LOGE(TAG, "Writing the RTC failed");
+  }
 }
 
 void BM8563::read_time() {
-
   BM8563_TimeTypeDef BM8563_TimeStruct;
   BM8563_DateTypeDef BM8563_DateStruct;
-  getTime(&BM8563_TimeStruct);
-  getDate(&BM8563_DateStruct);
-  ESP_LOGD(TAG, "BM8563: %i-%i-%i %i, %i:%i:%i",
+  if (!this->getDateTime(&BM8563_TimeStruct, &BM8563_DateStruct)) {
+    return;
+  }
+  ESP_LOGV(TAG, "BM8563: %i-%i-%i %i, %i:%i:%i",
     BM8563_DateStruct.year,
     BM8563_DateStruct.month,
     BM8563_DateStruct.day,
@@ -84,7 +146,7 @@ void BM8563::read_time() {
   ESPTime rtc_time{.second = uint8_t(BM8563_TimeStruct.seconds),
                          .minute = uint8_t(BM8563_TimeStruct.minutes),
                          .hour = uint8_t(BM8563_TimeStruct.hours),
-                         .day_of_week = uint8_t(BM8563_DateStruct.week),
+                         .day_of_week = uint8_t(BM8563_DateStruct.week + 1),
                          .day_of_month = uint8_t(BM8563_DateStruct.day),
                          .day_of_year = 1,  // ignored by recalc_timestamp_utc(false)
                          .month = uint8_t(BM8563_DateStruct.month),
@@ -93,6 +155,12 @@ void BM8563::read_time() {
                          .timestamp = 0  // result
                          };
   rtc_time.recalc_timestamp_utc(false);
+  if (!rtc_time.is_valid()) {
+    ESP_LOGW(TAG, "RTC holds no valid time");
+    return;
+  }
+  ESP_LOGD(TAG, "Synchronized from RTC: %04u-%02u-%02u %02u:%02u:%02u UTC", rtc_time.year, rtc_time.month,
+           rtc_time.day_of_month, rtc_time.hour, rtc_time.minute, rtc_time.second);
   time::RealTimeClock::synchronize_epoch_(rtc_time.timestamp);
 }
 
@@ -118,66 +186,47 @@ uint8_t BM8563::byteToBcd2(uint8_t value) {
   return ((uint8_t)(bcdhigh << 4) | value);
 }
 
-void BM8563::getTime(BM8563_TimeTypeDef* BM8563_TimeStruct) {
-  uint8_t buf[3] = {0};
-
-  this->read_register(0x02, buf, 3);
+bool BM8563::getDateTime(BM8563_TimeTypeDef* BM8563_TimeStruct, BM8563_DateTypeDef* BM8563_DateStruct) {
+  uint8_t buf[7] = {0};
+  if (this->read_register(0x02, buf, 7) != i2c::ERROR_OK) {
+    ESP_LOGE(TAG, "Reading the RTC failed");
+    return false;
+  }
+  if (buf[0] & 0x80) {
+    // VL: the oscillator stopped (battery ran flat), the clock is not trustworthy until it is written again
+    ESP_LOGW(TAG, "RTC lost power, ignoring its time");
+    return false;
+  }
 
   BM8563_TimeStruct->seconds = bcd2ToByte(buf[0] & 0x7f);
   BM8563_TimeStruct->minutes = bcd2ToByte(buf[1] & 0x7f);
   BM8563_TimeStruct->hours   = bcd2ToByte(buf[2] & 0x3f);
-}
-
-void BM8563::setTime(BM8563_TimeTypeDef* BM8563_TimeStruct) {
-  if (BM8563_TimeStruct == NULL) {
-    return;
-  }
-  uint8_t buf[3] = {
-    byteToBcd2(BM8563_TimeStruct->seconds),
-    byteToBcd2(BM8563_TimeStruct->minutes),
-    byteToBcd2(BM8563_TimeStruct->hours)
-  };
-
-  this->write_register(0x02, buf, 3);
-}
-
-void BM8563::getDate(BM8563_DateTypeDef* BM8563_DateStruct) {
-  uint8_t buf[4] = {0};
-  this->read_register(0x05, buf, 5);
 
-  BM8563_DateStruct->day    = bcd2ToByte(buf[0] & 0x3f);
-  BM8563_DateStruct->week = bcd2ToByte(buf[1] & 0x07);
-  BM8563_DateStruct->month   = bcd2ToByte(buf[2] & 0x1f);
-
-  uint8_t year_byte = bcd2ToByte(buf[3] & 0xff);
-  ESP_LOGD(TAG, "Year byte is %i", year_byte);
-  if (buf[2] & 0x80) {
-    BM8563_DateStruct->year = 1900 + year_byte;
-  } else {
-    BM8563_DateStruct->year = 2000 + year_byte;
-  }
+  BM8563_DateStruct->day   = bcd2ToByte(buf[3] & 0x3f);
+  BM8563_DateStruct->week  = bcd2ToByte(buf[4] & 0x07);
+  BM8563_DateStruct->month = bcd2ToByte(buf[5] & 0x1f);
+  // Century bit set means 19xx
+  BM8563_DateStruct->year  = (buf[5] & 0x80 ? 1900 : 2000) + bcd2ToByte(buf[6]);
+  return true;
 }
 
-void BM8563::setDate(BM8563_DateTypeDef* BM8563_DateStruct) {
-  if (BM8563_DateStruct == NULL) {
-    return;
+bool BM8563::setDateTime(const BM8563_TimeTypeDef* BM8563_TimeStruct, const BM8563_DateTypeDef* BM8563_DateStruct) {
+  if (BM8563_TimeStruct == NULL || BM8563_DateStruct == NULL) {
+    return false;
   }
-  uint8_t buf[4] = {
+  uint8_t buf[7] = {
+    byteToBcd2(BM8563_TimeStruct->seconds),  // also clears VL
+    byteToBcd2(BM8563_TimeStruct->minutes),
+    byteToBcd2(BM8563_TimeStruct->hours),
     byteToBcd2(BM8563_DateStruct->day),
     byteToBcd2(BM8563_DateStruct->week),
-    byteToBcd2(BM8563_DateStruct->month),
+    uint8_t(byteToBcd2(BM8563_DateStruct->month) | (BM8563_DateStruct->year < 2000 ? 0x80 : 0x00)),
     byteToBcd2((uint8_t)(BM8563_DateStruct->year % 100)),
   };
 
-
-  if (BM8563_DateStruct->year < 2000) {
-    buf[2] = byteToBcd2(BM8563_DateStruct->month) | 0x80;
-  } else {
-    buf[2] = byteToBcd2(BM8563_DateStruct->month) | 0x00;
-  }
-
-  ESP_LOGI(TAG, "Writing year is %i", buf[3]);
-  this->write_register(0x05, buf, 4);
+  ESP_LOGD(TAG, "Writing RTC: %04i-%02i-%02i %02i:%02i:%02i UTC", BM8563_DateStruct->year, BM8563_DateStruct->month,
+           BM8563_DateStruct->day, BM8563_TimeStruct->hours, BM8563_TimeStruct->minutes, BM8563_TimeStruct->seconds);
+  return this->write_register(0x02, buf, 7) == i2c::ERROR_OK;
 }
 
 void BM8563::WriteReg(uint8_t reg, uint8_t data) {
@@ -191,9 +240,11 @@ uint8_t BM8563::ReadReg(uint8_t reg) {
 }
 
 int BM8563::SetAlarmIRQ(int afterSeconds) {
-  ESP_LOGI(TAG, "Sleep Duration: %u ms", afterSeconds);
+  ESP_LOGI(TAG, "Sleep Duration: %i s", afterSeconds);
   uint8_t reg_value = 0;
   reg_value = ReadReg(0x01);
+  // The countdown replaces an absolute alarm
+  reg_value &= ~(1 << 1);
 
   if (afterSeconds < 0) {
     reg_value &= ~(1 << 0);
@@ -212,7 +263,8 @@ int BM8563::SetAlarmIRQ(int afterSeconds) {
     type_value = 0x82;
   }
 
-  afterSeconds = (afterSeconds / div) & 0xFF;
+  // Rounded rather than truncated; at most 255 minutes
+  afterSeconds = std::min((afterSeconds + div / 2) / div, 255);
   WriteReg(0x0F, afterSeconds);
   WriteReg(0x0E, type_value);
 
@@ -222,6 +274,95 @@ int BM8563::SetAlarmIRQ(int afterSeconds) {
   return afterSeconds * div;
 }
 
+int BM8563::SetAlarmIRQ(const BM8563_TimeTypeDef &BM8563_TimeStruct) {
+  BM8563_DateTypeDef any_day = {
+    day: -1,
+    week: -1,
+    month: -1,
+    year: -1
+  };
+  return this->SetAlarmIRQ(any_day, BM8563_TimeStruct);
+}
+
+int BM8563::SetAlarmIRQ(const BM8563_DateTypeDef &BM8563_DateStruct, const BM8563_TimeTypeDef &BM8563_TimeStruct) {
+  // Minute, hour, day and weekday alarm registers; a negative field sets AE (bit 7) so it matches any value.
+  // Seconds, month and year can not be matched.
+  uint8_t buf[4] = {
+    uint8_t(BM8563_TimeStruct.minutes >= 0 ? byteToBcd2(BM8563_TimeStruct.minutes) : 0x80),
+    uint8_t(BM8563_TimeStruct.hours >= 0 ? byteToBcd2(BM8563_TimeStruct.hours) : 0x80),
+    uint8_t(BM8563_DateStruct.day >= 0 ? byteToBcd2(BM8563_DateStruct.day) : 0x80),
+    uint8_t(BM8563_DateStruct.week >= 0 ? byteToBcd2(BM8563_DateStruct.week) : 0x80),
+  };
+  if (this->write_register(0x09, buf, 4) != i2c::ERROR_OK) {
+    return -1;
+  }
+
+  // Stop the countdown, so only the alarm wakes the device
+  WriteReg(0x0E, 0x03);
+  uint8_t reg_value = ReadReg(0x01);
+  reg_value &= ~((1 << 0) | (1 << 2) | (1 << 3));  // TIE, TF, AF
+  reg_value |= (1 << 1);                           // AIE
+  WriteReg(0x01, reg_value);
+  return 1;
+}
+
+int BM8563::setAlarmAtEpoch(time_t timestamp) {
+  // The RTC runs on UTC
+  ESPTime alarm = ESPTime::from_epoch_utc(timestamp);
+  BM8563_TimeTypeDef BM8563_TimeStruct = {
+    hours: int8_t(alarm.hour),
+    minutes: int8_t(alarm.minute),
+    seconds: 0,
+  };
+  BM8563_DateTypeDef BM8563_DateStruct = {
+    day: int8_t(alarm.day_of_month),
+    week: -1,
+    month: -1,
+    year: -1
+  };
+  if (this->SetAlarmIRQ(BM8563_DateStruct, BM8563_TimeStruct) < 0) {
+    ESP_LOGE(TAG, "Setting the alarm failed");
+    return -1;
+  }
+  const int remaining = int(timestamp - time::RealTimeClock::utcnow().timestamp);
+  ESP_LOGI(TAG, "Alarm at day %u %02u:%02u UTC, in %i s", alarm.day_of_month, alarm.hour, alarm.minute, remaining);
+  return remaining;
+}
+
+BM8563WakeReason BM8563::readWakeReason() {
+  const uint8_t control2 = ReadReg(0x01);
+  if ((control2 & (1 << 3)) && (control2 & (1 << 1))) {
+    return BM8563_WAKE_ALARM;
+  }
+  if ((control2 & (1 << 2)) && (control2 & (1 << 0))) {
+    return BM8563_WAKE_TIMER;
+  }
+#ifdef USE_ESP32
+  switch (esp_sleep_get_wakeup_cause()) {
+    case ESP_SLEEP_WAKEUP_EXT0:
+    case ESP_SLEEP_WAKEUP_EXT1:
+    case ESP_SLEEP_WAKEUP_GPIO:
+      return BM8563_WAKE_BUTTON;
+    default:
+      break;
+  }
+#endif
+  return BM8563_WAKE_POWER_ON;
+}
+
+const char *BM8563::get_wake_reason_name() const {
+  switch (this->wake_reason_) {
+    case BM8563_WAKE_ALARM:
+      return "alarm";
+    case BM8563_WAKE_TIMER:
+      return "timer";
+    case BM8563_WAKE_BUTTON:
+      return "button";
+    default:
+      return "power_on";
+  }
+}
+
 void BM8563::clearIRQ() {
   uint8_t data = ReadReg(0x01);
   WriteReg(0x01, data & 0xf3);
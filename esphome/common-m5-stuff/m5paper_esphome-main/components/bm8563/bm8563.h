@@ -3,6 +3,7 @@
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/time/real_time_clock.h"
+#include "esphome/components/text_sensor/text_sensor.h"
 
 namespace esphome {
 namespace bm8563 {
@@ -22,30 +23,66 @@ typedef struct
   int16_t year;
 } BM8563_DateTypeDef;
 
+enum BM8563SyncPolicy {
+  // Read the RTC in setup(), i.e. at boot and after every deep sleep wake, then keep the system clock
+  BM8563_SYNC_BOOT,
+  // Also read it on every update interval
+  BM8563_SYNC_INTERVAL,
+};
+
+enum BM8563WakeReason {
+  // Power button, reset or anything else
+  BM8563_WAKE_POWER_ON,
+  // Absolute alarm (apply_alarm_at / apply_alarm_every)
+  BM8563_WAKE_ALARM,
+  // Countdown timer (apply_sleep_duration)
+  BM8563_WAKE_TIMER,
+  // Deep sleep ended by a wakeup pin, i.e. a button
+  BM8563_WAKE_BUTTON,
+};
+
 class BM8563 : public time::RealTimeClock, public i2c::I2CDevice {
   public:
     void setup() override;
     void update() override;
     void dump_config() override;
 
+    void set_sync_policy(BM8563SyncPolicy sync_policy) { this->sync_policy_ = sync_policy; }
     void set_sleep_duration(uint32_t time_ms);
     void write_time();
     void read_time();
-    void apply_sleep_duration();
+    // Countdown of sleep_duration. Returns the seconds until it fires, -1 without a sleep_duration or before setup.
+    int apply_sleep_duration();
+    // Countdown from now, independent of the clock being set; at most 255 minutes. Same return value.
+    int apply_countdown(uint32_t seconds);
+
+    // Alarm at the next local hh:mm, or the next :mm of any hour if hour < 0. Minute resolution, firing on the
+    // full minute. Replaces a pending countdown. Returns the seconds until the alarm, -1 without valid time.
+    int apply_alarm_at(int hour, int minute);
+    // Alarm at the next local time that is a multiple of 'minutes' after midnight, e.g. 30 -> :00 and :30
+    int apply_alarm_every(uint32_t minutes);
+
+    // Why the device started, from the RTC flags read in setup() before they are cleared
+    BM8563WakeReason get_wake_reason() const { return this->wake_reason_; }
+    const char *get_wake_reason_name() const;
+    void set_wake_reason_text_sensor(text_sensor::TextSensor *wake_reason_text_sensor) {
+      this->wake_reason_text_sensor_ = wake_reason_text_sensor;
+    }
 
   private:
     bool getVoltLow();
 
-    void getTime(BM8563_TimeTypeDef* BM8563_TimeStruct);
-    void getDate(BM8563_DateTypeDef* BM8563_DateStruct);
-
-    void setTime(BM8563_TimeTypeDef* BM8563_TimeStruct);
-    void setDate(BM8563_DateTypeDef* BM8563_DateStruct);
+    // Seconds to years (0x02-0x08) in one transaction, so time and date can not tear across a rollover
+    bool getDateTime(BM8563_TimeTypeDef* BM8563_TimeStruct, BM8563_DateTypeDef* BM8563_DateStruct);
+    bool setDateTime(const BM8563_TimeTypeDef* BM8563_TimeStruct, const BM8563_DateTypeDef* BM8563_DateStruct);
 
     int SetAlarmIRQ(int afterSeconds);
     int SetAlarmIRQ(const BM8563_TimeTypeDef &BM8563_TimeStruct);
     int SetAlarmIRQ(const BM8563_DateTypeDef &BM8563_DateStruct, const BM8563_TimeTypeDef &BM8563_TimeStruct);
 
+    int setAlarmAtEpoch(time_t timestamp);
+    BM8563WakeReason readWakeReason();
+
     void clearIRQ();
     void disableIRQ();
 
@@ -55,8 +92,10 @@ class BM8563 : public time::RealTimeClock, public i2c::I2CDevice {
     uint8_t bcd2ToByte(uint8_t value);
     uint8_t byteToBcd2(uint8_t value);
 
-    uint8_t trdata[7];
     optional<uint32_t> sleep_duration_;
+    BM8563SyncPolicy sync_policy_{BM8563_SYNC_BOOT};
+    BM8563WakeReason wake_reason_{BM8563_WAKE_POWER_ON};
+    text_sensor::TextSensor *wake_reason_text_sensor_{nullptr};
     bool setupComplete;
 };
 
@@ -75,5 +114,20 @@ template<typename... Ts> class SleepAction : public Action<Ts...>, public Parent
   void play(Ts... x) override { this->parent_->apply_sleep_duration(); }
 };
 
+template<typename... Ts> class AlarmAtAction : public Action<Ts...>, public Parented<BM8563> {
+ public:
+  TEMPLATABLE_VALUE(int, hour)
+  TEMPLATABLE_VALUE(int, minute)
+
+  void play(Ts... x) override { this->parent_->apply_alarm_at(this->hour_.value(x...), this->minute_.value(x...)); }
+};
+
+template<typename... Ts> class AlarmEveryAction : public Action<Ts...>, public Parented<BM8563> {
+ public:
+  TEMPLATABLE_VALUE(uint32_t, minutes)
+
+  void play(Ts... x) override { this->parent_->apply_alarm_every(this->minutes_.value(x...)); }
+};
+
 }  // namespace bm8563
 }  // namespace esphome
\ No newline at end of file
@@ -1,22 +1,37 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
-from esphome.components import i2c, time
-from esphome.const import CONF_ID, CONF_SLEEP_DURATION
+from esphome.components import i2c, time, text_sensor
+from esphome.const import CONF_ID, CONF_SLEEP_DURATION, CONF_HOUR, CONF_MINUTE, CONF_INTERVAL
 
 DEPENDENCIES = ['i2c']
+AUTO_LOAD = ['text_sensor']
 
 CONF_I2C_ADDR = 0x51
+CONF_SYNC_POLICY = "sync_policy"
+CONF_WAKE_REASON = "wake_reason"
 
 bm8563 = cg.esphome_ns.namespace('bm8563')
 BM8563 = bm8563.class_('BM8563', cg.Component, i2c.I2CDevice)
 WriteAction = bm8563.class_("WriteAction", automation.Action)
 ReadAction = bm8563.class_("ReadAction", automation.Action)
 SleepAction = bm8563.class_("SleepAction", automation.Action)
+AlarmAtAction = bm8563.class_("AlarmAtAction", automation.Action)
+AlarmEveryAction = bm8563.class_("AlarmEveryAction", automation.Action)
+
+BM8563SyncPolicy = bm8563.enum("BM8563SyncPolicy")
+SYNC_POLICIES = {
+    "boot": BM8563SyncPolicy.BM8563_SYNC_BOOT,
+    "interval": BM8563SyncPolicy.BM8563_SYNC_INTERVAL,
+}
 
 CONFIG_SCHEMA = time.TIME_SCHEMA.extend({
     cv.GenerateID(): cv.declare_id(BM8563),
     cv.Optional(CONF_SLEEP_DURATION): cv.positive_time_period_milliseconds,
+    # boot: read the RTC only at boot / deep sleep wake and run on the system clock afterwards
+    cv.Optional(CONF_SYNC_POLICY, default="boot"): cv.enum(SYNC_POLICIES, lower=True),
+    # power_on, alarm, timer or button, published once at boot
+    cv.Optional(CONF_WAKE_REASON): text_sensor.text_sensor_schema(),
 }).extend(cv.COMPONENT_SCHEMA).extend(i2c.i2c_device_schema(CONF_I2C_ADDR))
 
 @automation.register_action(
@@ -47,6 +62,51 @@ async def bm8563_apply_sleep_duration_to_code(config, action_id, template_arg, a
     await cg.register_parented(var, config[CONF_ID])
     return var
 
+@automation.register_action(
+    "bm8563.apply_alarm_at",
+    AlarmAtAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(BM8563),
+            # Without hour: the next :minute of any hour
+            cv.Optional(CONF_HOUR, default=-1): cv.templatable(cv.int_range(min=-1, max=23)),
+            cv.Required(CONF_MINUTE): cv.templatable(cv.int_range(min=0, max=59)),
+        }
+    ),
+)
+async def bm8563_apply_alarm_at_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    hour = await cg.templatable(config[CONF_HOUR], args, cg.int_)
+    cg.add(var.set_hour(hour))
+    minute = await cg.templatable(config[CONF_MINUTE], args, cg.int_)
+    cg.add(var.set_minute(minute))
+    return var
+
+@automation.register_action(
+    "bm8563.apply_alarm_every",
+    AlarmEveryAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(BM8563),
+            # Aligned to local midnight, e.g. 30min wakes at :00 and :30 (a lambda returns minutes)
+            cv.Required(CONF_INTERVAL): cv.templatable(
+                cv.All(cv.positive_time_period_minutes, cv.Range(min=cv.TimePeriod(minutes=1)))
+            ),
+        }
+    ),
+)
+async def bm8563_apply_alarm_every_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    interval = config[CONF_INTERVAL]
+    if cg.is_template(interval):
+        interval = await cg.templatable(interval, args, cg.uint32)
+    else:
+        interval = interval.total_minutes
+    cg.add(var.set_minutes(interval))
+    return var
+
 @automation.register_action(
     "bm8563.read_time",
     ReadAction,
@@ -66,5 +126,9 @@ async def to_code(config):
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
     await time.register_time(var, config)
+    cg.add(var.set_sync_policy(config[CONF_SYNC_POLICY]))
+    if CONF_WAKE_REASON in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_WAKE_REASON])
+        cg.add(var.set_wake_reason_text_sensor(sens))
     if CONF_SLEEP_DURATION in config:
         cg.add(var.set_sleep_duration(config[CONF_SLEEP_DURATION]))
@@ -3,6 +3,7 @@ import esphome.config_validation as cv
 from esphome import core, pins
 from esphome import automation
 from esphome.components import display, spi
+from esphome.components.display_transport import BenchmarkTarget
 from esphome.const import __version__ as ESPHOME_VERSION
 from esphome.const import (
     CONF_NAME,
@@ -14,16 +15,30 @@ from esphome.const import (
     CONF_LAMBDA,
     CONF_MODEL,
     CONF_REVERSED,
+    CONF_FULL_UPDATE_EVERY,
+    CONF_TRIGGER_ID,
 )
 
 DEPENDENCIES = ['spi']
+AUTO_LOAD = ['display_transport']
 
 it8951e_ns = cg.esphome_ns.namespace('it8951e')
 IT8951ESensor = it8951e_ns.class_(
-    'IT8951ESensor', cg.PollingComponent, spi.SPIDevice, display.DisplayBuffer, display.Display
+    'IT8951ESensor', cg.PollingComponent, spi.SPIDevice, display.DisplayBuffer, display.Display, BenchmarkTarget
 )
 ClearAction = it8951e_ns.class_("ClearAction", automation.Action)
 UpdateSlowAction = it8951e_ns.class_("UpdateSlowAction", automation.Action)
+RefreshCompleteTrigger = it8951e_ns.class_("RefreshCompleteTrigger", automation.Trigger.template())
+PreloadPageAction = it8951e_ns.class_("PreloadPageAction", automation.Action)
+ShowSlotAction = it8951e_ns.class_("ShowSlotAction", automation.Action)
+BenchmarkAction = it8951e_ns.class_("BenchmarkAction", automation.Action)
+
+CONF_ON_REFRESH_COMPLETE = "on_refresh_complete"
+CONF_PAGE_SLOTS = "page_slots"
+CONF_SLOT = "slot"
+CONF_PAGE = "page"
+CONF_BITS_PER_PIXEL = "bits_per_pixel"
+CONF_READ_DATA_RATE = "read_data_rate"
 
 it8951eModel = it8951e_ns.enum("it8951eModel")
 
@@ -46,6 +61,20 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_MODEL, default="M5EPD"): cv.enum(
                 MODELS, upper=True, space="_"
             ),
+            # Partial refreshes of an area before it gets a GC16 cleanup (0 = never)
+            cv.Optional(CONF_FULL_UPDATE_EVERY, default=10): cv.uint32_t,
+            # 1 packs black/white pixels 8 to a byte: a quarter of the memory and upload bytes of 4
+            cv.Optional(CONF_BITS_PER_PIXEL, default=4): cv.one_of(1, 4, int=True),
+            # Register and status reads can be clocked slower than the pixel uploads (data_rate)
+            cv.Optional(CONF_READ_DATA_RATE): spi.SPI_DATA_RATE_SCHEMA,
+            # Frames kept in controller memory for it8951e.preload_page / it8951e.show_slot
+            cv.Optional(CONF_PAGE_SLOTS, default=0): cv.int_range(min=0, max=8),
+            # Fires when the panel has finished refreshing, e.g. to go to deep sleep right away
+            cv.Optional(CONF_ON_REFRESH_COMPLETE): automation.validate_automation(
+                {
+                    cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(RefreshCompleteTrigger),
+                }
+            ),
         }
     )
     .extend(cv.polling_component_schema("1s"))
@@ -71,12 +100,59 @@ CONFIG_SCHEMA = cv.All(
         }
     ),
 )
+@automation.register_action(
+    "it8951e.benchmark",
+    BenchmarkAction,
+    automation.maybe_simple_id(
+        {
+            cv.GenerateID(): cv.use_id(IT8951ESensor),
+        }
+    ),
+)
 
 async def it8951e_clear_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
     await cg.register_parented(var, config[CONF_ID])
     return var
 
+@automation.register_action(
+    "it8951e.preload_page",
+    PreloadPageAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(IT8951ESensor),
+            cv.Required(CONF_SLOT): cv.templatable(cv.uint8_t),
+            cv.Optional(CONF_PAGE): cv.use_id(display.DisplayPage),
+        }
+    ),
+)
+async def it8951e_preload_page_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    slot = await cg.templatable(config[CONF_SLOT], args, cg.uint8)
+    cg.add(var.set_slot(slot))
+    if CONF_PAGE in config:
+        page = await cg.get_variable(config[CONF_PAGE])
+        cg.add(var.set_page(page))
+    return var
+
+@automation.register_action(
+    "it8951e.show_slot",
+    ShowSlotAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(IT8951ESensor),
+            cv.Required(CONF_SLOT): cv.templatable(cv.uint8_t),
+        }
+    ),
+)
+async def it8951e_show_slot_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    slot = await cg.templatable(config[CONF_SLOT], args, cg.uint8)
+    cg.add(var.set_slot(slot))
+    return var
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     if cv.Version.parse(ESPHOME_VERSION) < cv.Version.parse("2023.12.0"):
@@ -101,3 +177,11 @@ async def to_code(config):
         cg.add(var.set_reversed(config[CONF_REVERSED]))
     if CONF_RESET_DURATION in config:
         cg.add(var.set_reset_duration(config[CONF_RESET_DURATION]))
+    cg.add(var.set_full_update_every(config[CONF_FULL_UPDATE_EVERY]))
+    cg.add(var.set_page_slots(config[CONF_PAGE_SLOTS]))
+    cg.add(var.set_bits_per_pixel(config[CONF_BITS_PER_PIXEL]))
+    if CONF_READ_DATA_RATE in config:
+        cg.add(var.set_read_data_rate(config[CONF_READ_DATA_RATE]))
+    for conf in config.get(CONF_ON_REFRESH_COMPLETE, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(trigger, [], conf)
@@ -4,23 +4,19 @@
 #include "esphome/core/application.h"
 #include "esphome/core/gpio.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace it8951e {
 
 static const char *TAG = "it8951e.display";
 
-void IT8951ESensor::write_two_byte16(uint16_t type, uint16_t cmd) {
-    this->wait_busy();
-    this->enable();
-
-    this->write_byte16(type);
-    this->wait_busy();
-    this->write_byte16(cmd);
-
-    this->disable();
-}
+// Pixel data is staged in chunks of this size and streamed within one chip-select
+static const size_t IT8951_BURST_CHUNK = 1024;
 
 uint16_t IT8951ESensor::read_word() {
+    this->set_spi_rate(this->read_data_rate_);
     this->wait_busy();
     this->enable();
     this->write_byte16(0x1000);
@@ -38,14 +34,12 @@ uint16_t IT8951ESensor::read_word() {
     return word;
 }
 
+/** @brief Read words straight into the caller's buffer, in one burst
+ * @param buf Destination, at least length words
+ * @param length Number of words
+ */
 void IT8951ESensor::read_words(void *buf, uint32_t length) {
-    ExternalRAMAllocator<uint16_t> allocator(ExternalRAMAllocator<uint16_t>::ALLOW_FAILURE);
-    uint16_t *buffer = allocator.allocate(length);
-    if (buffer == nullptr) {
-        ESP_LOGE(TAG, "Read FAILED to allocate.");
-        return;
-    }
-
+    this->set_spi_rate(this->read_data_rate_);
     this->wait_busy();
     this->enable();
     this->write_byte16(0x1000);
@@ -55,37 +49,30 @@ void IT8951ESensor::read_words(void *buf, uint32_t length) {
     this->write_byte16(0x0000);
     this->wait_busy();
 
-    for (size_t i = 0; i < length; i++) {
-        uint8_t recv[2];
-        this->read_array(recv, sizeof(recv));
-        buffer[i] = encode_uint16(recv[0], recv[1]);
-    }
+    uint8_t *bytes = static_cast<uint8_t *>(buf);
+    this->read_array(bytes, length * 2);
 
     this->disable();
 
-    memcpy(buf, buffer, length);
-
-    allocator.deallocate(buffer, length);
+    // Words arrive big endian: to host order, in place
+    for (uint32_t i = 0; i < length; i++) {
+        const uint16_t word = encode_uint16(bytes[2 * i], bytes[2 * i + 1]);
+        memcpy(bytes + 2 * i, &word, sizeof(word));
+    }
 }
 
-void IT8951ESensor:: write_command(uint16_t cmd) {
-    this->write_two_byte16(0x6000, cmd);
+void IT8951ESensor::write_command(uint16_t cmd) {
+    this->send_command16_(cmd);
 }
 
 void IT8951ESensor::write_word(uint16_t cmd) {
-    this->write_two_byte16(0x0000, cmd);
+    this->send_words_(&cmd, 1);
 }
 
 void IT8951ESensor::write_reg(uint16_t addr, uint16_t data) {
-    this->write_command(0x0011);  // tcon write reg command
-    this->wait_busy();
-    this->enable();
-    this->write_byte(0x0000); // Preamble
-    this->wait_busy();
-    this->write_byte16(addr);
-    this->wait_busy();
-    this->write_byte16(data);
-    this->disable();
+    // tcon write reg command, then address and value behind one 16-bit preamble
+    const uint16_t args[2] = {addr, data};
+    this->send_command16_(IT8951_TCON_REG_WR, args, 2);
 }
 
 void IT8951ESensor::set_target_memory_addr(uint16_t tar_addrL, uint16_t tar_addrH) {
@@ -94,16 +81,44 @@ void IT8951ESensor::set_target_memory_addr(uint16_t tar_addrL, uint16_t tar_addr
 }
 
 void IT8951ESensor::write_args(uint16_t cmd, uint16_t *args, uint16_t length) {
-    this->write_command(cmd);
-    for (uint16_t i = 0; i < length; i++) {
-        this->write_word(args[i]);
+    // All arguments share one chip-select and one preamble
+    this->send_command16_(cmd, args, length);
+}
+
+void IT8951ESensor::write_burst_begin() {
+    // Pack write (I80CPCR) is enabled in setup(): after one preamble every following word is pixel data
+    this->set_spi_rate(this->write_data_rate_);
+    this->begin_stream_();
+}
+
+void IT8951ESensor::write_burst_chunk(uint8_t *data, size_t length, bool invert) {
+    if (invert) {
+        // Bulk inversion, 32 bits at a time (chunks are word aligned, length is a multiple of 2)
+        uint32_t *words = reinterpret_cast<uint32_t *>(data);
+        for (size_t i = 0; i < length / 4; i++) {
+            words[i] = ~words[i];
+        }
+        for (size_t i = length & ~size_t(3); i < length; i++) {
+            data[i] = ~data[i];
+        }
     }
+    this->stream_(data, length);
+}
+
+void IT8951ESensor::write_burst_end() {
+    this->end_stream_();
+    this->write_command(IT8951_TCON_LD_IMG_END);
 }
 
 void IT8951ESensor::set_area(uint16_t x, uint16_t y, uint16_t w,
                                   uint16_t h) {
     uint16_t args[5];
 
+    // A 1bpp image is loaded as 8bpp data, 8 pixels per "pixel"
+    if (this->bpp_ == 1) {
+        x >>= 3;
+        w >>= 3;
+    }
     args[0] = (this->m_endian_type << 8 | this->m_pix_bpp << 4);
     args[1] = x;
     args[2] = y;
@@ -113,6 +128,9 @@ void IT8951ESensor::set_area(uint16_t x, uint16_t y, uint16_t w,
 }
 
 void IT8951ESensor::wait_busy(uint32_t timeout) {
+    // HRDY is the only flow control of the host interface, so busy_pin is required. The wait stays a
+    // short spin: the controller is ready again within microseconds between words, far less than the
+    // cost of arming an interrupt for each one.
     uint32_t start_time = millis();
     while (1) {
         if (this->busy_pin_->digital_read()) {
@@ -126,21 +144,94 @@ void IT8951ESensor::wait_busy(uint32_t timeout) {
     }
 }
 
-void IT8951ESensor::check_busy(uint32_t timeout) {
-    uint32_t start_time = millis();
-    while (1) {
-        this->write_command(IT8951_TCON_REG_RD);
-        this->write_word(IT8951_LUTAFSR);
-        uint16_t word = this->read_word();
-        if (word == 0) {
-            break;
-        }
+uint16_t IT8951ESensor::read_reg(uint16_t addr) {
+    this->write_command(IT8951_TCON_REG_RD);
+    this->write_word(addr);
+    return this->read_word();
+}
 
-        if (millis() - start_time > timeout) {
-            ESP_LOGE(TAG, "SPI busy timeout %i", word);
+uint16_t IT8951ESensor::read_lut_status() {
+    // One bit per LUT engine that is still running a waveform
+    return this->read_reg(IT8951_LUTAFSR);
+}
+
+void IT8951ESensor::start_refresh_poll() {
+    // The waveform runs for hundreds of milliseconds: check on it from the scheduler, not in a loop
+    this->refreshing_ = true;
+    this->refresh_started_ = millis();
+    this->set_interval("lut_poll", IT8951_LUT_POLL_MS, [this]() { this->poll_refresh(); });
+}
+
+void IT8951ESensor::poll_refresh() {
+    const uint16_t status = this->read_lut_status();
+    if (status != 0) {
+        if (millis() - this->refresh_started_ < IT8951_REFRESH_TIMEOUT_MS) {
             return;
         }
+        ESP_LOGW(TAG, "Refresh timeout, LUT status 0x%04X", status);
+    }
+    this->cancel_interval("lut_poll");
+    this->refreshing_ = false;
+    this->last_refresh_.waveform_ms = millis() - this->refresh_started_;
+
+    if (this->pending_slot_ >= 0) {
+        const uint8_t slot = this->pending_slot_;
+        this->pending_slot_ = -1;
+        this->show_slot(slot);
+        return;
+    }
+    if (this->refresh_pending_) {
+        this->refresh_pending_ = false;
+        this->write_display(this->refresh_pending_full_);
+        return;
+    }
+    this->write_command(IT8951_TCON_SLEEP);
+    this->finish_refresh(true);
+}
 
+void IT8951ESensor::finish_refresh(bool refreshed) {
+    if (this->benchmark_step_ >= 0) {
+        if (this->benchmark_waiting_) {
+            this->benchmark_[this->benchmark_step_ - 1] = this->last_refresh_;
+            this->benchmark_waiting_ = false;
+        }
+        this->defer([this]() { this->run_benchmark_step(); });
+    }
+    // on_refresh_complete only after a waveform actually ran; idle also after an update without changes
+    if (refreshed) {
+        this->refresh_complete_callback_.call();
+    }
+    this->idle_callback_.call();
+}
+
+void IT8951ESensor::sleep() {
+    this->cancel_interval("lut_poll");
+    this->refreshing_ = false;
+    this->refresh_pending_ = false;
+    this->pending_slot_ = -1;
+    this->write_command(IT8951_TCON_SLEEP);
+}
+
+const char *IT8951ESensor::mode_name(update_mode_e mode) {
+    switch (mode) {
+    case update_mode_e::UPDATE_MODE_INIT:
+        return "INIT";
+    case update_mode_e::UPDATE_MODE_DU:
+        return "DU";
+    case update_mode_e::UPDATE_MODE_GC16:
+        return "GC16";
+    case update_mode_e::UPDATE_MODE_GL16:
+        return "GL16";
+    case update_mode_e::UPDATE_MODE_GLR16:
+        return "GLR16";
+    case update_mode_e::UPDATE_MODE_GLD16:
+        return "GLD16";
+    case update_mode_e::UPDATE_MODE_DU4:
+        return "DU4";
+    case update_mode_e::UPDATE_MODE_A2:
+        return "A2";
+    default:
+        return "NONE";
     }
 }
 
@@ -150,11 +241,14 @@ void IT8951ESensor::update_area(uint16_t x, uint16_t y, uint16_t w,
         return;
     }
 
-    // rounded up to be multiple of 4
-    x = (x + 3) & 0xFFFC;
-    y = (y + 3) & 0xFFFC;
+    // x and w must be multiples of 4: round x down and the right edge up, so the area still covers
+    // every pixel that was asked for
+    const uint16_t x_end = x + w;
+    x &= 0xFFFC;
+    w = (x_end - x + 3) & 0xFFFC;
 
-    this->check_busy();
+    // No wait for the LUT engines here: regions of one refresh do not overlap, and the controller runs
+    // them on separate engines. A new refresh is only started once the previous one has completed.
 
     if (x + w > this->get_width_internal()) {
         w = this->get_width_internal() - x;
@@ -169,12 +263,23 @@ void IT8951ESensor::update_area(uint16_t x, uint16_t y, uint16_t w,
     args[2] = w;
     args[3] = h;
     args[4] = mode;
-    args[5] = this->IT8951DevAll[this->model_].devInfo.usImgBufAddrL;
-    args[6] = this->IT8951DevAll[this->model_].devInfo.usImgBufAddrH;
+    args[5] = this->image_addr_ & 0xFFFF;
+    args[6] = this->image_addr_ >> 16;
 
     this->write_args(IT8951_I80_CMD_DPY_BUF_AREA, args, 7);
 }
 
+void IT8951ESensor::set_spi_rate(uint32_t rate) {
+    // The SPI bus applies the rate when the device registers, so re-register with the new one.
+    // Commands run at whichever rate is set; only uploads and reads switch.
+    if (this->data_rate_ == rate) {
+        return;
+    }
+    this->spi_teardown();
+    this->data_rate_ = rate;
+    this->spi_setup();
+}
+
 void IT8951ESensor::reset(void) {
     this->reset_pin_->digital_write(true);
     this->reset_pin_->digital_write(false);
@@ -183,11 +288,24 @@ void IT8951ESensor::reset(void) {
     delay(100);
 }
 
-uint32_t IT8951ESensor::get_buffer_length_() { return this->get_width_internal() * this->get_height_internal(); }
+uint32_t IT8951ESensor::get_buffer_length_() { return this->buffer_stride() * this->get_height_internal(); }
 
-void IT8951ESensor::get_device_info(struct IT8951DevInfo_s *info) {
+bool IT8951ESensor::get_device_info(struct IT8951DevInfo_s *info) {
     this->write_command(IT8951_I80_CMD_GET_DEV_INFO);
-    this->read_words(info, sizeof(struct IT8951DevInfo_s)/2); // Polling HRDY for each words(2-bytes) if possible
+    this->read_words(info, sizeof(struct IT8951DevInfo_s)/2);
+
+    // The version strings are bytes in wire order: undo the word swap of read_words()
+    for (char *str : {info->usFWVersion, info->usLUTVersion}) {
+        for (size_t i = 0; i + 1 < sizeof(info->usFWVersion); i += 2) {
+            std::swap(str[i], str[i + 1]);
+        }
+        str[sizeof(info->usFWVersion) - 1] = '\0';
+    }
+
+    // A controller that is not (yet) answering reads as all zeros or all ones
+    return info->usPanelW != 0 && info->usPanelW <= IT8951_MAX_PANEL_SIZE &&
+           info->usPanelH != 0 && info->usPanelH <= IT8951_MAX_PANEL_SIZE &&
+           (info->usImgBufAddrL | info->usImgBufAddrH) != 0;
 }
 
 uint16_t IT8951ESensor::get_vcom() {
@@ -207,6 +325,11 @@ void IT8951ESensor::set_vcom(uint16_t vcom) {
 void IT8951ESensor::setup() {
     ESP_LOGCONFIG(TAG, "Init Starting.");
     this->spi_setup();
+    this->set_transport_preambles(0x6000, 0x0000);  // command, write data
+    this->write_data_rate_ = this->data_rate_;
+    if (this->read_data_rate_ == 0) {
+        this->read_data_rate_ = this->write_data_rate_;
+    }
 
     if (nullptr != this->reset_pin_) {
         this->reset_pin_->pin_mode(gpio::FLAG_OUTPUT);
@@ -215,7 +338,19 @@ void IT8951ESensor::setup() {
 
     this->busy_pin_->pin_mode(gpio::FLAG_INPUT);
 
-//    this->get_device_info(&(this->device_info_));
+    struct IT8951DevInfo_s info{};
+    this->device_info_read_ = this->get_device_info(&info);
+    if (this->device_info_read_) {
+        this->IT8951DevAll[this->model_].devInfo = info;
+    } else {
+        ESP_LOGW(TAG, "No valid device info, using the model defaults");
+    }
+
+    // Cells grow until 64 of them cover the panel
+    while (((this->get_width_internal() + this->cell_size() - 1) >> this->cell_shift_) > IT8951_MAX_CELL_COLS ||
+           ((this->get_height_internal() + this->cell_size() - 1) >> this->cell_shift_) > IT8951_MAX_CELL_ROWS) {
+        this->cell_shift_++;
+    }
     this->dump_config();
 
     this->write_command(IT8951_TCON_SYS_RUN);
@@ -223,6 +358,12 @@ void IT8951ESensor::setup() {
     // enable pack write
     this->write_reg(IT8951_I80CPCR, 0x0001);
 
+    if (this->bpp_ == 1) {
+        // 1bpp display mode (UP1SR bit 18), set bits are shown white and clear bits black
+        this->write_reg(IT8951_UP1SR + 2, this->read_reg(IT8951_UP1SR + 2) | (1 << 2));
+        this->write_reg(IT8951_BGVR, (0x00 << 8) | 0xF0);
+    }
+
     // set vcom to -2.30v
     uint16_t vcom = this->get_vcom();
     if (2300 != vcom) {
@@ -230,76 +371,443 @@ void IT8951ESensor::setup() {
         this->get_vcom();
     }
 
-    ExternalRAMAllocator<uint8_t> buffer_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-    this->should_write_buffer_ = buffer_allocator.allocate(this->get_buffer_length_());
-    if (this->should_write_buffer_ == nullptr) {
+    this->image_addr_ = this->IT8951DevAll[this->model_].devInfo.usImgBufAddrL |
+                        (uint32_t(this->IT8951DevAll[this->model_].devInfo.usImgBufAddrH) << 16);
+
+    this->init_internal_(this->get_buffer_length_());
+    if (this->buffer_ == nullptr) {
         ESP_LOGE(TAG, "Init FAILED.");
         return;
     }
 
-    this->init_internal_(this->get_buffer_length_());
+    // Shadow of the controller's image buffer: refreshes only upload what differs from it
+    ExternalRAMAllocator<uint8_t> buffer_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    this->shadow_buffer_ = buffer_allocator.allocate(this->get_buffer_length_());
+    if (this->shadow_buffer_ == nullptr) {
+        ESP_LOGW(TAG, "No shadow buffer, uploading every dirty region in full");
+    }
+
+    // Nothing is known about the panel content yet: no black/white history, so the first refresh is not A2
+    const uint16_t cell_cols = (this->get_width_internal() + this->cell_size() - 1) >> this->cell_shift_;
+    const uint16_t cell_rows = (this->get_height_internal() + this->cell_size() - 1) >> this->cell_shift_;
+    this->cell_state_.assign(cell_cols * cell_rows, 0);
+
+    // Page slots follow the image buffer in controller memory, one frame each. The controller keeps
+    // a byte per pixel whatever the load format (a 1bpp frame uses the first width/8 bytes of each row).
+    const uint32_t frame_bytes = this->get_buffer_length_();
+    const uint32_t slot_bytes = uint32_t(this->get_width_internal()) * this->get_height_internal();
+    for (uint8_t i = 0; i < this->page_slots_; i++) {
+        PageSlot slot{this->image_addr_ + (i + 1) * slot_bytes, buffer_allocator.allocate(frame_bytes), false};
+        if (slot.frame == nullptr) {
+            ESP_LOGW(TAG, "Only %u of %u page slots allocated", i, this->page_slots_);
+            break;
+        }
+        this->slots_.push_back(slot);
+    }
 
     ESP_LOGCONFIG(TAG, "Init Done.");
 }
 
 /** @brief Write the image at the specified location, Partial update
- * @param x Update X coordinate, >>> Must be a multiple of 4 <<<
+ * @param x Update X coordinate, >>> Must be a multiple of 4 (16 in 1bpp mode) <<<
  * @param y Update Y coordinate
- * @param w width of gram, >>> Must be a multiple of 4 <<<
+ * @param w width of gram, >>> Must be a multiple of 4 (16 in 1bpp mode) <<<
  * @param h height of gram
- * @param gram 4bpp gram data
+ * @param gram 4bpp or 1bpp gram data
+ * @param addr Controller image buffer to load into
  */
-void IT8951ESensor::write_buffer_to_display(uint16_t x, uint16_t y, uint16_t w,
+void IT8951ESensor::write_buffer_to_display(uint32_t addr, uint16_t x, uint16_t y, uint16_t w,
                                             uint16_t h, const uint8_t *gram) {
     this->m_endian_type = IT8951_LDIMG_B_ENDIAN;
-    this->m_pix_bpp     = IT8951_4BPP;
+    this->m_pix_bpp     = this->bpp_ == 1 ? IT8951_8BPP : IT8951_4BPP;
     if (x > this->get_width() || y > this->get_height()) {
         ESP_LOGE(TAG, "Pos (%d, %d) out of bounds.", x, y);
         return;
     }
 
-    this->set_target_memory_addr(this->IT8951DevAll[this->model_].devInfo.usImgBufAddrL, this->IT8951DevAll[this->model_].devInfo.usImgBufAddrH);
+    this->set_target_memory_addr(addr & 0xFFFF, addr >> 16);
     this->set_area(x, y, w, h);
 
-    uint32_t pos = 0;
-    uint16_t word = 0;
-    for (uint32_t x = 0; x < ((w * h) >> 2); x++) {
-        word = gram[pos] << 8 | gram[pos + 1];
+    // The rows of the area are gathered from the framebuffer and streamed as one burst
+    alignas(4) uint8_t chunk[IT8951_BURST_CHUNK];
+    const uint32_t stride = this->buffer_stride();
+    const uint32_t row_bytes = this->byte_of(w);
+    const bool invert = !this->reversed_;
+    size_t used = 0;
+
+    this->write_burst_begin();
+    for (uint32_t row = y; row < uint32_t(y + h); row++) {
+        const uint8_t *src = gram + row * stride + this->byte_of(x);
+        uint32_t left = row_bytes;
+        while (left > 0) {
+            const size_t n = std::min<size_t>(left, sizeof(chunk) - used);
+            memcpy(chunk + used, src, n);
+            used += n;
+            src += n;
+            left -= n;
+            if (used == sizeof(chunk)) {
+                this->write_burst_chunk(chunk, used, invert);
+                used = 0;
+            }
+        }
+    }
+    if (used > 0) {
+        this->write_burst_chunk(chunk, used, invert);
+    }
+    this->write_burst_end();
+}
 
-        if (!this->reversed_) {
-            word = 0xFFFF - word;
+void IT8951ESensor::drop_unchanged_cells() {
+    // Drawing marks every cell it touches, also where it only repaints what was there (auto_clear fills the
+    // whole screen before every page): keep the cells whose pixels differ from what the controller holds
+    const uint32_t stride = this->buffer_stride();
+    const int width = this->get_width_internal();
+    const int height = this->get_height_internal();
+    for (uint16_t cy = 0; cy < IT8951_MAX_CELL_ROWS; cy++) {
+        uint64_t mask = this->dirty_cells_[cy];
+        if (mask == 0) {
+            continue;
+        }
+        const uint32_t y1 = cy << this->cell_shift_;
+        const uint32_t y2 = std::min<int>((cy + 1) << this->cell_shift_, height);
+        for (uint16_t cx = 0; cx < IT8951_MAX_CELL_COLS; cx++) {
+            const uint64_t bit = 1ULL << cx;
+            if (!(mask & bit)) {
+                continue;
+            }
+            const uint32_t b1 = this->byte_of(cx << this->cell_shift_);
+            const uint32_t b2 = this->byte_of(std::min<int>((cx + 1) << this->cell_shift_, width));
+            bool changed = false;
+            for (uint32_t y = y1; y < y2 && !changed; y++) {
+                changed = memcmp(this->buffer_ + y * stride + b1, this->shadow_buffer_ + y * stride + b1, b2 - b1) != 0;
+            }
+            if (!changed) {
+                mask &= ~bit;
+            }
         }
+        this->dirty_cells_[cy] = mask;
+    }
+}
 
-        this->enable();
-        this->write_byte16(0);
-        this->write_byte16(word);
-        this->disable();
-        pos += 2;
+void IT8951ESensor::collect_regions() {
+    // Turns the dirty cells into rectangles: a run of dirty cells in one cell row grows downwards
+    // while the rows below contain the same run. Rectangles are then merged pairwise, cheapest first,
+    // as long as the union is not mostly empty (at most twice the pixels of both), or while there are
+    // more than IT8951_MAX_REGIONS of them. A union swallows every region it overlaps.
+    this->regions_.clear();
+    if (this->shadow_buffer_ != nullptr && this->shadow_valid_) {
+        this->drop_unchanged_cells();
+    }
+    const uint16_t cell_cols = (this->get_width_internal() + this->cell_size() - 1) >> this->cell_shift_;
+    const uint16_t cell_rows = (this->get_height_internal() + this->cell_size() - 1) >> this->cell_shift_;
+
+    for (uint16_t cy = 0; cy < cell_rows; cy++) {
+        while (this->dirty_cells_[cy] != 0) {
+            const uint64_t mask = this->dirty_cells_[cy];
+            uint16_t cx1 = 0;
+            while (!(mask & (1ULL << cx1))) {
+                cx1++;
+            }
+            uint16_t cx2 = cx1;
+            while (cx2 + 1 < cell_cols && (mask & (1ULL << (cx2 + 1)))) {
+                cx2++;
+            }
+            const uint64_t run = ((cx2 + 1 < 64 ? (1ULL << (cx2 + 1)) : 0) - 1) & ~((1ULL << cx1) - 1);
+
+            uint16_t cy2 = cy;
+            this->dirty_cells_[cy] &= ~run;
+            while (cy2 + 1 < cell_rows && (this->dirty_cells_[cy2 + 1] & run) == run) {
+                cy2++;
+                this->dirty_cells_[cy2] &= ~run;
+            }
+
+            DirtyRegion region;
+            region.x1 = cx1 << this->cell_shift_;
+            region.y1 = cy << this->cell_shift_;
+            region.x2 = std::min<int>((cx2 + 1) << this->cell_shift_, this->get_width_internal()) - 1;
+            region.y2 = std::min<int>((cy2 + 1) << this->cell_shift_, this->get_height_internal()) - 1;
+            this->regions_.push_back(region);
+        }
     }
 
-    this->write_command(IT8951_TCON_LD_IMG_END);
+    while (this->regions_.size() > 1) {
+        size_t best_i = 0, best_j = 0;
+        uint32_t best_cost = UINT32_MAX;
+        DirtyRegion best_union{};
+        for (size_t i = 0; i < this->regions_.size(); i++) {
+            for (size_t j = i + 1; j < this->regions_.size(); j++) {
+                const DirtyRegion &a = this->regions_[i];
+                const DirtyRegion &b = this->regions_[j];
+                const DirtyRegion u{std::min(a.x1, b.x1), std::min(a.y1, b.y1), std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+                const uint32_t used = a.area() + b.area();
+                const uint32_t cost = u.area() > used ? u.area() - used : 0;
+                const bool mostly_empty = u.area() > 2 * used;
+                if ((!mostly_empty || this->regions_.size() > IT8951_MAX_REGIONS) && cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_j = j;
+                    best_union = u;
+                }
+            }
+        }
+        if (best_cost == UINT32_MAX) {
+            break;
+        }
+        this->regions_.erase(this->regions_.begin() + best_j);
+        // The union may now overlap other regions: absorb them as well (the union grows with each one),
+        // so regions of one refresh never overlap
+        for (size_t k = 0; k < this->regions_.size();) {
+            const DirtyRegion &other = this->regions_[k];
+            if (k == best_i || !best_union.intersects(other)) {
+                k++;
+                continue;
+            }
+            best_union = DirtyRegion{std::min(best_union.x1, other.x1), std::min(best_union.y1, other.y1),
+                                     std::max(best_union.x2, other.x2), std::max(best_union.y2, other.y2)};
+            this->regions_.erase(this->regions_.begin() + k);
+            if (k < best_i) {
+                best_i--;
+            }
+            k = 0;
+        }
+        this->regions_[best_i] = best_union;
+    }
 }
 
-void IT8951ESensor::write_display() {
-    this->write_command(IT8951_TCON_SYS_RUN);
-    this->write_buffer_to_display(this->min_x, this->min_y, this->max_x, this->max_y, this->buffer_);
-    this->update_area(this->min_x, this->min_y, this->max_x, this->max_y, update_mode_e::UPDATE_MODE_DU);   // 2 level
-    this->max_x = 0;
-    this->max_y = 0;
-    this->min_x = 960;
-    this->min_y = 540;
-    this->write_command(IT8951_TCON_SLEEP);
+IT8951ESensor::update_mode_e IT8951ESensor::pick_update_mode(const DirtyRegion &region, bool &black_white) {
+    // Picks the waveform from the new content of the region:
+    //  - only black and white: A2 if the cells held only black and white before as well, otherwise DU
+    //  - a few gray pixels on a mostly paper-colored background (anti-aliased text): GL16
+    //  - anything else (images, large gray areas): GC16
+    // A region whose cells had full_update_every_ partial refreshes gets GC16 to clear the ghosting.
+    const uint8_t paper = this->reversed_ ? 0x0F : 0x00;
+    const uint8_t ink = paper ^ 0x0F;
+    const uint32_t stride = this->buffer_stride();
+    uint32_t paper_pixels = 0;
+    uint32_t gray_pixels = 0;
+    // A 1bpp framebuffer holds nothing but black and white
+    for (uint32_t y = region.y1; this->bpp_ == 4 && y <= region.y2; y++) {
+        const uint8_t *row = this->buffer_ + y * stride;
+        for (uint32_t i = region.x1 >> 1; i <= uint32_t(region.x2 >> 1); i++) {
+            for (uint8_t nibble : {uint8_t(row[i] >> 4), uint8_t(row[i] & 0x0F)}) {
+                if (nibble == paper) {
+                    paper_pixels++;
+                } else if (nibble != ink) {
+                    gray_pixels++;
+                }
+            }
+        }
+    }
+    black_white = gray_pixels == 0;
+
+    const uint16_t cell_cols = (this->get_width_internal() + this->cell_size() - 1) >> this->cell_shift_;
+    bool was_black_white = true;
+    uint8_t partial_refreshes = 0;
+    for (uint16_t cy = region.y1 >> this->cell_shift_; cy <= region.y2 >> this->cell_shift_; cy++) {
+        for (uint16_t cx = region.x1 >> this->cell_shift_; cx <= region.x2 >> this->cell_shift_; cx++) {
+            const uint8_t state = this->cell_state_[cy * cell_cols + cx];
+            was_black_white &= (state & IT8951_CELL_BW) != 0;
+            partial_refreshes = std::max<uint8_t>(partial_refreshes, state & IT8951_CELL_COUNT_MASK);
+        }
+    }
+
+    if (this->full_update_every_ != 0 && partial_refreshes >= this->full_update_every_) {
+        return update_mode_e::UPDATE_MODE_GC16;
+    }
+    if (black_white) {
+        return was_black_white ? update_mode_e::UPDATE_MODE_A2 : update_mode_e::UPDATE_MODE_DU;
+    }
+    const uint32_t total = region.area();
+    if (gray_pixels * 4 < total && paper_pixels * 2 >= total) {
+        return update_mode_e::UPDATE_MODE_GL16;
+    }
+    return update_mode_e::UPDATE_MODE_GC16;
+}
+
+bool IT8951ESensor::diff_region(DirtyRegion &region) {
+    // Compares the region with the shadow, 32 bits at a time, and shrinks it to the pixels that differ.
+    // Changed rows are grouped into segments_, split where more than IT8951_SEGMENT_GAP rows are unchanged;
+    // each segment keeps the columns its own rows changed in. Returns false if nothing in the region differs.
+    this->segments_.clear();
+    const uint32_t stride = this->buffer_stride();
+    const uint32_t b1 = this->byte_of(region.x1);
+    const uint32_t b2 = this->byte_of(region.x2);
+    uint32_t first_byte = UINT32_MAX;
+    uint32_t last_byte = 0;
+    int32_t segment_start = -1;
+    int32_t last_changed = -1;
+
+    for (uint32_t y = region.y1; y <= region.y2; y++) {
+        const uint8_t *now = this->buffer_ + y * stride;
+        const uint8_t *was = this->shadow_buffer_ + y * stride;
+        int32_t first = -1;
+        int32_t last = -1;
+        uint32_t i = b1;
+        for (; i + 4 <= b2 + 1; i += 4) {
+            uint32_t a, b;
+            memcpy(&a, now + i, sizeof(a));
+            memcpy(&b, was + i, sizeof(b));
+            if (a != b) {
+                if (first < 0) {
+                    first = i;
+                }
+                last = i + 3;
+            }
+        }
+        for (; i <= b2; i++) {
+            if (now[i] != was[i]) {
+                if (first < 0) {
+                    first = i;
+                }
+                last = i;
+            }
+        }
+        if (first < 0) {
+            continue;
+        }
+
+        if (segment_start >= 0 && int32_t(y) - last_changed > IT8951_SEGMENT_GAP) {
+            this->push_segment(first_byte, last_byte, segment_start, last_changed);
+            segment_start = -1;
+        }
+        if (segment_start < 0) {
+            segment_start = y;
+            first_byte = UINT32_MAX;
+            last_byte = 0;
+        }
+        first_byte = std::min<uint32_t>(first_byte, first);
+        last_byte = std::max<uint32_t>(last_byte, last);
+        last_changed = y;
+    }
+
+    if (segment_start < 0) {
+        return false;
+    }
+    this->push_segment(first_byte, last_byte, segment_start, last_changed);
+
+    // The region becomes the bounding box of its segments: one waveform for all of them
+    region = this->segments_.front();
+    for (const DirtyRegion &segment : this->segments_) {
+        region.x1 = std::min(region.x1, segment.x1);
+        region.x2 = std::max(region.x2, segment.x2);
+        region.y2 = segment.y2;
+    }
+    return true;
 }
 
-void IT8951ESensor::write_display_slow() {
+void IT8951ESensor::push_segment(uint32_t first_byte, uint32_t last_byte, uint16_t y1, uint16_t y2) {
+    // Back to pixels, aligned for the upload
+    const uint32_t pixels_per_byte = 8 / this->bpp_;
+    const uint16_t align = this->pixel_align();
+    const uint16_t x1 = (first_byte * pixels_per_byte) & ~(align - 1);
+    const uint16_t x2 = std::min<int>(((last_byte + 1) * pixels_per_byte - 1) | (align - 1),
+                                      this->get_width_internal() - 1);
+    this->segments_.push_back(DirtyRegion{x1, y1, x2, y2});
+}
+
+void IT8951ESensor::write_display(bool full_quality) {
+    // The previous waveform is still running: refresh again once it is done (the framebuffer keeps changing)
+    if (this->refreshing_) {
+        this->refresh_pending_ = true;
+        this->refresh_pending_full_ |= full_quality;
+        return;
+    }
+    this->refresh_pending_full_ = false;
+    this->last_refresh_ = RefreshStats{};
+
+    this->collect_regions();
+    if (this->regions_.empty()) {
+        this->finish_refresh(false);
+        return;
+    }
+
+    // Every region is uploaded and refreshed on its own, with its own waveform
+    const uint16_t cell_cols = (this->get_width_internal() + this->cell_size() - 1) >> this->cell_shift_;
     this->write_command(IT8951_TCON_SYS_RUN);
-    this->write_buffer_to_display(this->min_x, this->min_y, this->max_x, this->max_y, this->buffer_);
-    this->update_area(this->min_x, this->min_y, this->max_x, this->max_y, update_mode_e::UPDATE_MODE_GC16);
-    this->max_x = 0;
-    this->max_y = 0;
-    this->min_x = 960;
-    this->min_y = 540;
-    this->write_command(IT8951_TCON_SLEEP);
+    bool refreshed = false;
+    uint32_t largest_area = 0;
+    for (DirtyRegion &region : this->regions_) {
+        // Regions the controller already holds cost nothing; the others shrink to what differs
+        const bool use_shadow = this->shadow_buffer_ != nullptr && this->shadow_valid_;
+        if (use_shadow && !this->diff_region(region)) {
+            continue;
+        }
+
+        bool black_white = false;
+        update_mode_e mode = this->pick_update_mode(region, black_white);
+        if (this->forced_mode_ != update_mode_e::UPDATE_MODE_NONE) {
+            mode = this->forced_mode_;
+        }
+        if (full_quality) {
+            mode = update_mode_e::UPDATE_MODE_GC16;
+        }
+        ESP_LOGV(TAG, "Refresh (%u, %u)-(%u, %u) with mode %u", region.x1, region.y1, region.x2, region.y2, mode);
+
+        const uint32_t upload_start = micros();
+        if (use_shadow) {
+            for (const DirtyRegion &segment : this->segments_) {
+                this->write_buffer_to_display(this->image_addr_, segment.x1, segment.y1, segment.x2 - segment.x1 + 1,
+                                              segment.y2 - segment.y1 + 1, this->buffer_);
+                this->last_refresh_.upload_bytes += this->byte_of(segment.x2 - segment.x1 + 1) * (segment.y2 - segment.y1 + 1);
+            }
+        } else {
+            this->write_buffer_to_display(this->image_addr_, region.x1, region.y1, region.x2 - region.x1 + 1,
+                                          region.y2 - region.y1 + 1, this->buffer_);
+            this->last_refresh_.upload_bytes += this->byte_of(region.x2 - region.x1 + 1) * (region.y2 - region.y1 + 1);
+        }
+        this->last_refresh_.upload_us += micros() - upload_start;
+        this->update_area(region.x1, region.y1, region.x2 - region.x1 + 1, region.y2 - region.y1 + 1, mode);
+        refreshed = true;
+
+        this->last_refresh_.regions++;
+        this->last_refresh_.area += region.area();
+        if (region.area() > largest_area) {
+            largest_area = region.area();
+            this->last_refresh_.mode = mode;
+        }
+
+        // The shadow follows what was uploaded: the segments, or the whole region without a valid shadow
+        if (this->shadow_buffer_ != nullptr) {
+            const uint32_t stride = this->buffer_stride();
+            const DirtyRegion *uploaded = use_shadow ? this->segments_.data() : &region;
+            const size_t uploaded_count = use_shadow ? this->segments_.size() : 1;
+            for (size_t n = 0; n < uploaded_count; n++) {
+                const DirtyRegion &area = uploaded[n];
+                const uint32_t row_bytes = this->byte_of(area.x2) - this->byte_of(area.x1) + 1;
+                for (uint32_t y = area.y1; y <= area.y2; y++) {
+                    const uint32_t offset = y * stride + this->byte_of(area.x1);
+                    memcpy(this->shadow_buffer_ + offset, this->buffer_ + offset, row_bytes);
+                }
+            }
+        }
+
+        for (uint16_t cy = region.y1 >> this->cell_shift_; cy <= region.y2 >> this->cell_shift_; cy++) {
+            for (uint16_t cx = region.x1 >> this->cell_shift_; cx <= region.x2 >> this->cell_shift_; cx++) {
+                uint8_t &state = this->cell_state_[cy * cell_cols + cx];
+                uint8_t count = state & IT8951_CELL_COUNT_MASK;
+                if (mode == update_mode_e::UPDATE_MODE_GC16) {
+                    count = 0;
+                } else if (count < IT8951_CELL_COUNT_MASK) {
+                    count++;
+                }
+                state = count | (black_white ? IT8951_CELL_BW : 0);
+            }
+        }
+    }
+
+    // A full-screen upload makes the shadow trustworthy (the panel content before it is unknown)
+    if (this->shadow_buffer_ != nullptr && !this->shadow_valid_) {
+        this->shadow_valid_ = this->regions_.size() == 1 && this->regions_[0].area() ==
+                              uint32_t(this->get_width_internal()) * this->get_height_internal();
+    }
+
+    // The controller goes to sleep once the waveforms have finished
+    if (refreshed) {
+        this->start_refresh_poll();
+    } else {
+        this->write_command(IT8951_TCON_SLEEP);
+        this->finish_refresh(false);
+    }
 }
 
 
@@ -308,37 +816,235 @@ void IT8951ESensor::write_display_slow() {
  */
 void IT8951ESensor::clear(bool init) {
     this->m_endian_type = IT8951_LDIMG_L_ENDIAN;
-    this->m_pix_bpp     = IT8951_4BPP;
+    this->m_pix_bpp     = this->bpp_ == 1 ? IT8951_8BPP : IT8951_4BPP;
 
-    this->set_target_memory_addr(this->IT8951DevAll[this->model_].devInfo.usImgBufAddrL, this->IT8951DevAll[this->model_].devInfo.usImgBufAddrH);
+    this->set_target_memory_addr(this->image_addr_ & 0xFFFF, this->image_addr_ >> 16);
     this->set_area(0, 0, this->get_width_internal(), this->get_height_internal());
-    uint32_t looping = (this->get_width_internal() * this->get_height_internal()) >> 2;
-
-    for (uint32_t x = 0; x < looping; x++) {
-        this->enable();
-        this->write_byte16(0x0000);
-        this->write_byte16(0xFFFF);
-        this->disable();
+    // All white, streamed as one burst
+    alignas(4) uint8_t chunk[IT8951_BURST_CHUNK];
+    memset(chunk, 0xFF, sizeof(chunk));
+    uint32_t left = this->get_buffer_length_();
+    this->last_refresh_ = RefreshStats{};
+    this->last_refresh_.upload_bytes = left;
+    const uint32_t upload_start = micros();
+
+    this->write_burst_begin();
+    while (left > 0) {
+        const size_t n = std::min<size_t>(left, sizeof(chunk));
+        this->write_burst_chunk(chunk, n, false);
+        left -= n;
     }
+    this->write_burst_end();
+    this->last_refresh_.upload_us = micros() - upload_start;
 
-    this->write_command(IT8951_TCON_LD_IMG_END);
+    // The controller now holds paper color everywhere
+    if (this->shadow_buffer_ != nullptr) {
+        memset(this->shadow_buffer_, this->reversed_ ? 0xFF : 0x00, this->get_buffer_length_());
+        this->shadow_valid_ = true;
+    }
 
     if (init) {
         this->update_area(0, 0, this->get_width_internal(), this->get_height_internal(), update_mode_e::UPDATE_MODE_INIT);
+        this->last_refresh_.regions = 1;
+        this->last_refresh_.area = uint32_t(this->get_width_internal()) * this->get_height_internal();
+        this->last_refresh_.mode = update_mode_e::UPDATE_MODE_INIT;
+        if (!this->refreshing_) {
+            this->start_refresh_poll();
+        }
+    }
+}
+
+bool IT8951ESensor::preload_page(uint8_t slot, display::DisplayPage *page) {
+    if (slot >= this->slots_.size() || this->buffer_ == nullptr) {
+        ESP_LOGE(TAG, "Page slot %u not available", slot);
+        return false;
+    }
+    PageSlot &target = this->slots_[slot];
+
+    // Rendered into the slot's own frame: the live framebuffer and its dirty cells stay as they are
+    uint64_t dirty_cells[IT8951_MAX_CELL_ROWS];
+    memcpy(dirty_cells, this->dirty_cells_, sizeof(dirty_cells));
+    uint8_t *live = this->buffer_;
+    display::DisplayPage *current = this->page_;
+    this->buffer_ = target.frame;
+    if (page != nullptr) {
+        this->page_ = page;
+    }
+    this->do_update_();
+    this->page_ = current;
+    this->buffer_ = live;
+    memcpy(this->dirty_cells_, dirty_cells, sizeof(dirty_cells));
+
+    // Only an upload into memory the panel is not showing, so it may overlap a running waveform
+    this->write_command(IT8951_TCON_SYS_RUN);
+    this->write_buffer_to_display(target.addr, 0, 0, this->get_width_internal(), this->get_height_internal(),
+                                  target.frame);
+    if (!this->refreshing_) {
+        this->write_command(IT8951_TCON_SLEEP);
+    }
+    target.valid = true;
+    return true;
+}
+
+bool IT8951ESensor::show_slot(uint8_t slot) {
+    if (slot >= this->slots_.size() || !this->slots_[slot].valid) {
+        ESP_LOGE(TAG, "Page slot %u not loaded", slot);
+        return false;
+    }
+    if (this->refreshing_) {
+        this->pending_slot_ = slot;
+        return true;
+    }
+    PageSlot &target = this->slots_[slot];
+
+    // The slot becomes the live image buffer and the live one takes its place, so showing the slot again flips
+    // back. The host copies are swapped along with them, and the framebuffer starts from the shown frame.
+    std::swap(this->image_addr_, target.addr);
+    if (this->shadow_buffer_ != nullptr) {
+        const bool live_valid = this->shadow_valid_;
+        std::swap(this->shadow_buffer_, target.frame);
+        this->shadow_valid_ = true;
+        target.valid = live_valid;
+        memcpy(this->buffer_, this->shadow_buffer_, this->get_buffer_length_());
+    } else {
+        // Without a shadow the previous frame is not known on the host
+        memcpy(this->buffer_, target.frame, this->get_buffer_length_());
+        target.valid = false;
+    }
+    memset(this->dirty_cells_, 0, sizeof(this->dirty_cells_));
+    this->refresh_pending_ = false;
+    this->cell_state_.assign(this->cell_state_.size(), 0);
+
+    this->write_command(IT8951_TCON_SYS_RUN);
+    this->update_area(0, 0, this->get_width_internal(), this->get_height_internal(), update_mode_e::UPDATE_MODE_GC16);
+    this->start_refresh_poll();
+    return true;
+}
+
+void IT8951ESensor::start_benchmark() {
+    if (this->benchmark_step_ >= 0 || this->buffer_ == nullptr) {
+        return;
+    }
+    ESP_LOGI(TAG, "Benchmark started");
+    this->benchmark_step_ = 0;
+    this->benchmark_waiting_ = false;
+    // A refresh in flight finishes first, its completion starts the suite
+    if (!this->refreshing_) {
+        this->run_benchmark_step();
+    }
+}
+
+void IT8951ESensor::run_benchmark_step() {
+    // One refresh per step, the next step starts from the completion of the previous one:
+    //   0: full screen gray, GC16    1: full screen black/white, DU    2: 128x128 box, DU
+    //   3: two 30x30 boxes in opposite corners, DU (must stay two small regions)
+    //   4..: a 64x64 box moving by its width per frame, A2
+    if (this->benchmark_step_ < 0 || this->benchmark_waiting_ || this->refreshing_) {
+        return;
+    }
+    const int width = this->get_width_internal();
+    const int height = this->get_height_internal();
+    const uint8_t step = this->benchmark_step_;
+
+    if (step == IT8951_BENCH_STEPS) {
+        const RefreshStats *a2 = &this->benchmark_[IT8951_BENCH_A2_FIRST];
+        uint32_t a2_upload_us = 0, a2_waveform_ms = 0;
+        for (uint8_t i = 0; i < IT8951_BENCH_A2_FRAMES; i++) {
+            a2_upload_us += a2[i].upload_us;
+            a2_waveform_ms += a2[i].waveform_ms;
+        }
+        ESP_LOGI(TAG, "Benchmark (upload bytes / upload ms / waveform ms):");
+        static const char *const NAMES[IT8951_BENCH_A2_FIRST] = {"Full GC16", "Full DU", "Small DU", "Corners DU"};
+        for (uint8_t i = 0; i < IT8951_BENCH_A2_FIRST; i++) {
+            const RefreshStats &r = this->benchmark_[i];
+            ESP_LOGI(TAG, "  %-10s %7u B %8.1f ms %5u ms", NAMES[i], (unsigned) r.upload_bytes, r.upload_us / 1000.0f,
+                     (unsigned) r.waveform_ms);
+        }
+        ESP_LOGI(TAG, "  %-10s %7u B %8.1f ms %5u ms (per frame, %u frames)", "A2 anim", (unsigned) a2[0].upload_bytes,
+                 a2_upload_us / 1000.0f / IT8951_BENCH_A2_FRAMES, (unsigned) (a2_waveform_ms / IT8951_BENCH_A2_FRAMES),
+                 IT8951_BENCH_A2_FRAMES);
+        this->benchmark_step_ = -1;
+        this->update();
+        return;
+    }
+
+    const int box = 64;
+    const int box_y = (height - box) / 2;
+    update_mode_e mode = update_mode_e::UPDATE_MODE_A2;
+    if (step == 0) {
+        this->fill_rect(0, 0, width, height, Color(0x77, 0x77, 0x77));
+        mode = update_mode_e::UPDATE_MODE_GC16;
+    } else if (step == 1) {
+        this->fill_rect(0, 0, width, height, Color::BLACK);
+        mode = update_mode_e::UPDATE_MODE_DU;
+    } else if (step == 2) {
+        this->fill_rect((width - 128) / 2, (height - 128) / 2, 128, 128, Color::WHITE);
+        mode = update_mode_e::UPDATE_MODE_DU;
+    } else if (step == 3) {
+        // Off the 4 pixel grid on purpose
+        this->fill_rect(10, 10, 30, 30, Color::WHITE);
+        this->fill_rect(width - 41, height - 41, 30, 30, Color::WHITE);
+        mode = update_mode_e::UPDATE_MODE_DU;
+    } else {
+        const int frame = step - IT8951_BENCH_A2_FIRST;
+        if (frame == 0) {
+            this->fill_rect((width - 128) / 2, (height - 128) / 2, 128, 128, Color::BLACK);
+        } else {
+            this->fill_rect(box * frame, box_y, box, box, Color::BLACK);
+        }
+        this->fill_rect(box * (frame + 1), box_y, box, box, Color::WHITE);
+    }
+
+    this->benchmark_step_++;
+    this->benchmark_waiting_ = true;
+    this->forced_mode_ = mode;
+    this->write_display(false);
+    this->forced_mode_ = update_mode_e::UPDATE_MODE_NONE;
+    if (step == 3) {
+        if (this->check_corner_regions()) {
+            ESP_LOGI(TAG, "Corner boxes refreshed as two separate aligned regions");
+        } else {
+            ESP_LOGW(TAG, "Corner boxes not refreshed as two small aligned regions (%u regions, %u pixels)",
+                     this->last_refresh_.regions, (unsigned) this->last_refresh_.area);
+        }
+    }
+}
+
+bool IT8951ESensor::check_corner_regions() {
+    // After benchmark step 3: each box has its own update_area, aligned, and no larger than its cells
+    if (this->last_refresh_.regions != 2) {
+        return false;
+    }
+    const uint16_t align = this->pixel_align();
+    const uint32_t limit = uint32_t(30 + 2 * this->cell_size()) * (30 + 2 * this->cell_size());
+    for (const DirtyRegion &region : this->regions_) {
+        const bool right_aligned = (region.x2 + 1) % align == 0 || region.x2 == this->get_width_internal() - 1;
+        if (region.x1 % align != 0 || !right_aligned || region.area() > limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void IT8951ESensor::fill_rect(int x, int y, int w, int h, Color color) {
+    for (int row = y; row < y + h; row++) {
+        for (int col = x; col < x + w; col++) {
+            this->draw_absolute_pixel_internal(col, row, color);
+        }
     }
 }
 
 void IT8951ESensor::update() {
     if (this->is_ready()) {
         this->do_update_();
-        this->write_display();
+        this->write_display(false);
     }
 }
 
 void IT8951ESensor::update_slow() {
     if (this->is_ready()) {
         this->do_update_();
-        this->write_display_slow();
+        this->write_display(true);
     }
 }
 
@@ -353,23 +1059,21 @@ void HOT IT8951ESensor::draw_absolute_pixel_internal(int x, int y, Color color)
         return;
     }
 
-    if (x > this->max_x) {
-        this->max_x = x;
-    }
-
-    if (y > this->max_y) {
-        this->max_y = y;
-    }
-
-    if (x < this->min_x) {
-        this->min_x = x;
-    }
+    this->dirty_cells_[y >> this->cell_shift_] |= 1ULL << (x >> this->cell_shift_);
 
-    if (y < this->min_y) {
-        this->min_y = y;
+    uint32_t internal_color = color.raw_32 & 0x0F;
+    if (this->bpp_ == 1) {
+        // Anything from mid gray up is ink
+        const uint32_t index = y * this->buffer_stride() + (x >> 3);
+        const uint8_t bit = 0x80 >> (x & 0x7);
+        if (internal_color >= 0x08) {
+            this->buffer_[index] |= bit;
+        } else {
+            this->buffer_[index] &= ~bit;
+        }
+        return;
     }
 
-    uint32_t internal_color = color.raw_32 & 0x0F;
     uint16_t _bytewidth = this->get_width_internal() >> 1;
     int32_t index = y * _bytewidth + (x >> 1);
 
@@ -400,7 +1104,14 @@ void IT8951ESensor::dump_config() {
         ESP_LOGCONFIG(TAG, "  Model: unkown");
         break;
     }
-    ESP_LOGCONFIG(TAG, "LUT: %s, FW: %s, Mem:%x",
+    ESP_LOGCONFIG(TAG, "  Panel: %dx%d (%s)", this->get_width_internal(), this->get_height_internal(),
+                  this->device_info_read_ ? "detected" : "default");
+    ESP_LOGCONFIG(TAG, "  SPI Data Rate: %u Hz write, %u Hz read", (unsigned) this->write_data_rate_,
+                  (unsigned) this->read_data_rate_);
+    ESP_LOGCONFIG(TAG, "  Full Update Every: %u", (unsigned) this->full_update_every_);
+    ESP_LOGCONFIG(TAG, "  Page Slots: %u", (unsigned) this->page_slots_);
+    ESP_LOGCONFIG(TAG, "  Bits Per Pixel: %u", (unsigned) this->bpp_);
+    ESP_LOGCONFIG(TAG, "LUT: %.16s, FW: %.16s, Mem:%x",
         this->IT8951DevAll[this->model_].devInfo.usLUTVersion,
         this->IT8951DevAll[this->model_].devInfo.usFWVersion,
         this->IT8951DevAll[this->model_].devInfo.usImgBufAddrL | (this->IT8951DevAll[this->model_].devInfo.usImgBufAddrH << 16)
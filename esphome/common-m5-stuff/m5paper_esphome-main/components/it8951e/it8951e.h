@@ -1,13 +1,62 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/automation.h"
 #include "esphome/core/version.h"
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display_transport/display_transport.h"
+
+#include <vector>
 
 namespace esphome {
 namespace it8951e {
 
+// Dirty tracking: drawn pixels mark 16x16 cells (a multiple of the 4 pixel alignment the controller needs),
+// which are turned into a short list of rectangles per refresh. 64 columns of cells cover 1024 pixels;
+// on larger panels the cells grow to 32x32 and up.
+static const uint16_t IT8951_CELL_SIZE = 16;
+static const uint16_t IT8951_MAX_CELL_COLS = 64;
+static const uint16_t IT8951_MAX_CELL_ROWS = 64;
+// More regions than this are merged regardless of the pixels they add
+static const uint8_t IT8951_MAX_REGIONS = 8;
+// Per-cell refresh state: partial refreshes since the last GC16, and whether the last content was black/white
+static const uint8_t IT8951_CELL_COUNT_MASK = 0x7F;
+static const uint8_t IT8951_CELL_BW = 0x80;
+// Waveform completion is polled from the scheduler (LUTAFSR) instead of blocking the loop
+static const uint32_t IT8951_LUT_POLL_MS = 20;
+static const uint32_t IT8951_REFRESH_TIMEOUT_MS = 5000;
+// Unchanged rows between changed ones before a region is uploaded as separate row segments
+static const uint16_t IT8951_SEGMENT_GAP = 4;
+// Largest panel side accepted from the controller's device info
+static const uint16_t IT8951_MAX_PANEL_SIZE = 4096;
+// it8951e.benchmark: full GC16, full DU, small DU, two far-apart boxes (DU), then this many A2 animation frames
+static const uint8_t IT8951_BENCH_A2_FRAMES = 8;
+static const uint8_t IT8951_BENCH_A2_FIRST = 4;
+static const uint8_t IT8951_BENCH_STEPS = IT8951_BENCH_A2_FIRST + IT8951_BENCH_A2_FRAMES;
+// Whole frames kept in the controller's SDRAM behind the image buffer, for page switches without an upload
+static const uint8_t IT8951_MAX_PAGE_SLOTS = 8;
+
+// Area to upload and refresh, in pixels (inclusive)
+struct DirtyRegion {
+  uint16_t x1;
+  uint16_t y1;
+  uint16_t x2;
+  uint16_t y2;
+
+  uint32_t area() const { return uint32_t(x2 - x1 + 1) * (y2 - y1 + 1); }
+  bool intersects(const DirtyRegion &other) const {
+    return x1 <= other.x2 && other.x1 <= x2 && y1 <= other.y2 && other.y1 <= y2;
+  }
+};
+
+// A frame in controller memory, with the host copy it was uploaded from
+struct PageSlot {
+  uint32_t addr;
+  uint8_t *frame;
+  bool valid;
+};
+
 enum it8951eModel
 {
   M5EPD = 0,
@@ -20,7 +69,9 @@ class IT8951ESensor : public display::DisplayBuffer,
 class IT8951ESensor : public PollingComponent, public display::DisplayBuffer,
 #endif  // VERSION_CODE(2023, 12, 0)
                       public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING,
-                                            spi::DATA_RATE_20MHZ> {
+                                            spi::DATA_RATE_20MHZ>,
+                      public display_transport::SPIDisplayTransport,
+                      public display_transport::BenchmarkTarget {
  public:
   float get_loop_priority() const override { return 0.0f; };
   float get_setup_priority() const override { return setup_priority::PROCESSOR; };
@@ -124,12 +175,32 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
       UPDATE_MODE_NONE = 8
   };  // The ones marked with * are more commonly used
 
+  // What the last refresh did: upload volume and time, waveform time (LUTAFSR polled, so +/- IT8951_LUT_POLL_MS),
+  // refreshed area and the mode of its largest region
+  struct RefreshStats {
+    uint32_t upload_bytes{0};
+    uint32_t upload_us{0};
+    uint32_t waveform_ms{0};
+    uint32_t area{0};
+    uint8_t regions{0};
+    update_mode_e mode{UPDATE_MODE_NONE};
+  };
+
+  static const char *mode_name(update_mode_e mode);
+
   void set_reset_pin(GPIOPin *reset) { this->reset_pin_ = reset; }
   void set_busy_pin(GPIOPin *busy) { this->busy_pin_ = busy; }
 
   void set_reversed(bool reversed) { this->reversed_ = reversed; }
   void set_reset_duration(uint32_t reset_duration) { this->reset_duration_ = reset_duration; }
   void set_model(it8951eModel model) { this->model_ = model; }
+  // Partial (DU/A2/GL16) refreshes of a cell before its region gets a GC16 cleanup, 0 = never
+  void set_full_update_every(uint32_t full_update_every) { this->full_update_every_ = full_update_every; }
+  void set_page_slots(uint8_t page_slots) { this->page_slots_ = page_slots; }
+  // 4 (16 gray levels) or 1 (black/white, loaded through the controller's 1bpp bitmap mode)
+  void set_bits_per_pixel(uint8_t bits_per_pixel) { this->bpp_ = bits_per_pixel; }
+  // SPI clock for reads (data_rate is used for pixel uploads), 0 = same as data_rate
+  void set_read_data_rate(uint32_t read_data_rate) { this->read_data_rate_ = read_data_rate; }
 
   void setup() override;
   void update() override;
@@ -140,6 +211,33 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
 
   void clear(bool init);
 
+  // True from the first refresh command until every LUT engine has finished its waveform
+  bool is_refreshing() const { return this->refreshing_; }
+  // Stops waiting for a running refresh and puts the controller to sleep (TCON_SLEEP), e.g. before power off
+  void sleep();
+  // Called once the panel has finished refreshing and the controller is asleep
+  void add_on_refresh_complete_callback(std::function<void()> &&callback) {
+    this->refresh_complete_callback_.add(std::move(callback));
+  }
+  // Called whenever an update has been dealt with and the controller is asleep, also when nothing had
+  // changed and no waveform ran (on_refresh_complete does not fire then)
+  void add_on_idle_callback(std::function<void()> &&callback) { this->idle_callback_.add(std::move(callback)); }
+
+  // display_benchmark: a fast refresh of what changed, busy until the waveform has finished
+  void benchmark_flush() override { this->write_display(false); }
+  bool benchmark_busy() override { return this->refreshing_ || this->refresh_pending_; }
+  display_transport::SPIDisplayTransport *benchmark_transport() override { return this; }
+
+  // Renders a page (the current one if nullptr) and uploads it into a slot, without refreshing the panel
+  bool preload_page(uint8_t slot, display::DisplayPage *page);
+  // Shows a preloaded slot with one display command; the frame shown before takes its place in the slot
+  bool show_slot(uint8_t slot);
+  uint8_t get_page_slot_count() const { return this->slots_.size(); }
+
+  const RefreshStats &get_last_refresh() const { return this->last_refresh_; }
+  // Runs the refresh suite on the panel and logs how long each step took; update() redraws afterwards
+  void start_benchmark();
+
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
 
@@ -162,15 +260,57 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
     display::DisplayType::DISPLAY_TYPE_GRAYSCALE // .displayType (M5EPD supports 16 gray scale levels)
   };
 
-  uint8_t *should_write_buffer_{nullptr};
-  void get_device_info(struct IT8951DevInfo_s *info);
-
-  uint32_t max_x = 0;
-  uint32_t max_y = 0;
-  uint32_t min_x = 960;
-  uint32_t min_y = 540;
+  // Controller address of the image buffer that is shown and updated (a slot's after show_slot())
+  uint32_t image_addr_{0};
+  uint8_t page_slots_{0};
+  std::vector<PageSlot> slots_;
+  // show_slot() requested while the previous waveform was still running
+  int16_t pending_slot_{-1};
+
+  // What the controller's image buffer holds, in framebuffer format (only valid once shadow_valid_)
+  uint8_t *shadow_buffer_{nullptr};
+  bool shadow_valid_{false};
+  bool get_device_info(struct IT8951DevInfo_s *info);
+
+  // One bit per cell column, one entry per cell row
+  uint64_t dirty_cells_[IT8951_MAX_CELL_ROWS]{};
+  std::vector<DirtyRegion> regions_;
+  std::vector<DirtyRegion> segments_;
+  std::vector<uint8_t> cell_state_;
+
+  bool refreshing_{false};
+  uint32_t refresh_started_{0};
+  // A refresh requested while the previous waveform was still running
+  bool refresh_pending_{false};
+  bool refresh_pending_full_{false};
+  CallbackManager<void()> refresh_complete_callback_;
+  CallbackManager<void()> idle_callback_;
+  RefreshStats last_refresh_{};
+
+  // Waveform for every region instead of pick_update_mode(), UPDATE_MODE_NONE = not forced
+  update_mode_e forced_mode_{UPDATE_MODE_NONE};
+  // Next benchmark step, -1 = no benchmark; a step's results arrive with its refresh completion
+  int8_t benchmark_step_{-1};
+  bool benchmark_waiting_{false};
+  RefreshStats benchmark_[IT8951_BENCH_STEPS];
+  uint32_t full_update_every_{10};
+  uint8_t bpp_{4};
+  uint32_t write_data_rate_{0};
+  uint32_t read_data_rate_{0};
   uint16_t m_endian_type, m_pix_bpp;
 
+  // Framebuffer geometry for bpp_: bytes per row, byte of a pixel column, and the pixel alignment of
+  // uploads (4 pixels, or 16 in 1bpp mode where the area is loaded as 8bpp words of 16 pixels)
+  uint32_t buffer_stride() { return (uint32_t(this->get_width_internal()) * this->bpp_) >> 3; }
+  uint32_t byte_of(uint32_t x) const { return (x * this->bpp_) >> 3; }
+  uint16_t pixel_align() const { return this->bpp_ == 1 ? 16 : 4; }
+
+  // Dirty cells are (1 << cell_shift_) pixels square: IT8951_CELL_SIZE, grown in setup() for large panels
+  uint8_t cell_shift_{4};
+  uint16_t cell_size() const { return 1 << this->cell_shift_; }
+  // Panel size and image buffer come from the controller, IT8951DevAll is the fallback
+  bool device_info_read_{false};
+
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *busy_pin_{nullptr};
@@ -180,9 +320,16 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
   enum it8951eModel model_{it8951eModel::M5EPD};
 
   void reset(void);
+  void set_spi_rate(uint32_t rate);
 
   void wait_busy(uint32_t timeout = 30);
-  void check_busy(uint32_t timeout = 30);
+  uint16_t read_reg(uint16_t addr);
+  uint16_t read_lut_status();
+  void start_refresh_poll();
+  void poll_refresh();
+  void finish_refresh(bool refreshed);
+  void run_benchmark_step();
+  void fill_rect(int x, int y, int w, int h, Color color);
 
   uint16_t get_vcom();
   void set_vcom(uint16_t vcom);
@@ -191,7 +338,13 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
   uint16_t read_word();
   void read_words(void *buf, uint32_t length);
 
-  void write_two_byte16(uint16_t type, uint16_t cmd);
+  // Commands and arguments go through the shared transport (preamble framing; wait_busy() before each preamble
+  // and command word, argument words are written together behind their preamble)
+  void transport_enable_() override { this->enable(); }
+  void transport_disable_() override { this->disable(); }
+  void transport_write_(const uint8_t *data, size_t length) override { this->write_array(data, length); }
+  void transport_wait_ready_() override { this->wait_busy(); }
+
   void write_command(uint16_t cmd);
   void write_word(uint16_t cmd);
   void write_reg(uint16_t addr, uint16_t data);
@@ -199,15 +352,25 @@ shown in Figure 1. The use of a white image in the transition from 4-bit to
   void write_args(uint16_t cmd, uint16_t *args, uint16_t length);
 
   void set_area(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+  // Image data after LD_IMG_AREA: one chip-select, one preamble, then the packed pixel words
+  void write_burst_begin();
+  void write_burst_chunk(uint8_t *data, size_t length, bool invert);
+  void write_burst_end();
   void update_area(uint16_t x, uint16_t y, uint16_t w,
                     uint16_t h, update_mode_e mode);
 
 
 
-  void write_buffer_to_display(uint16_t x, uint16_t y, uint16_t w,
+  void write_buffer_to_display(uint32_t addr, uint16_t x, uint16_t y, uint16_t w,
                                 uint16_t h, const uint8_t *gram);
-  void write_display();
-  void write_display_slow();
+  void drop_unchanged_cells();
+  void collect_regions();
+  bool check_corner_regions();
+  bool diff_region(DirtyRegion &region);
+  void push_segment(uint32_t first_byte, uint32_t last_byte, uint16_t y1, uint16_t y2);
+  update_mode_e pick_update_mode(const DirtyRegion &region, bool &black_white);
+  void write_display(bool full_quality);
 };
 
 template<typename... Ts> class ClearAction : public Action<Ts...>, public Parented<IT8951ESensor> {
@@ -215,10 +378,40 @@ template<typename... Ts> class ClearAction : public Action<Ts...>, public Parent
   void play(Ts... x) override { this->parent_->clear(true); }
 };
 
+class RefreshCompleteTrigger : public Trigger<> {
+ public:
+  explicit RefreshCompleteTrigger(IT8951ESensor *parent) {
+    parent->add_on_refresh_complete_callback([this]() { this->trigger(); });
+  }
+};
+
 template<typename... Ts> class UpdateSlowAction : public Action<Ts...>, public Parented<IT8951ESensor> {
  public:
   void play(Ts... x) override { this->parent_->update_slow(); }
 };
 
+template<typename... Ts> class BenchmarkAction : public Action<Ts...>, public Parented<IT8951ESensor> {
+ public:
+  void play(Ts... x) override { this->parent_->start_benchmark(); }
+};
+
+template<typename... Ts> class PreloadPageAction : public Action<Ts...>, public Parented<IT8951ESensor> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, slot)
+  void set_page(display::DisplayPage *page) { this->page_ = page; }
+
+  void play(Ts... x) override { this->parent_->preload_page(this->slot_.value(x...), this->page_); }
+
+ protected:
+  display::DisplayPage *page_{nullptr};
+};
+
+template<typename... Ts> class ShowSlotAction : public Action<Ts...>, public Parented<IT8951ESensor> {
+ public:
+  TEMPLATABLE_VALUE(uint8_t, slot)
+
+  void play(Ts... x) override { this->parent_->show_slot(this->slot_.value(x...)); }
+};
+
 }  // namespace it8951e
 }  // namespace esphome
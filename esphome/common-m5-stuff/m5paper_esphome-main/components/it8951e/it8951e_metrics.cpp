@@ -0,0 +1,48 @@
+#include "it8951e_metrics.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace it8951e {
+
+static const char *TAG = "it8951e.metrics";
+
+void IT8951EMetrics::setup() {
+    this->parent_->add_on_refresh_complete_callback([this]() { this->publish_(); });
+}
+
+void IT8951EMetrics::publish_() {
+    const IT8951ESensor::RefreshStats &stats = this->parent_->get_last_refresh();
+    // Refreshes that found nothing to change are not worth a data point
+    if (stats.regions == 0) {
+        return;
+    }
+
+    if (this->upload_bytes_sensor_ != nullptr) {
+        this->upload_bytes_sensor_->publish_state(stats.upload_bytes);
+    }
+    if (this->upload_time_sensor_ != nullptr) {
+        this->upload_time_sensor_->publish_state(stats.upload_us / 1000.0f);
+    }
+    if (this->waveform_time_sensor_ != nullptr) {
+        this->waveform_time_sensor_->publish_state(stats.waveform_ms);
+    }
+    if (this->refresh_area_sensor_ != nullptr) {
+        const float screen = float(this->parent_->get_width()) * this->parent_->get_height();
+        this->refresh_area_sensor_->publish_state(screen > 0 ? stats.area * 100.0f / screen : 0.0f);
+    }
+    if (this->refresh_mode_text_sensor_ != nullptr) {
+        this->refresh_mode_text_sensor_->publish_state(IT8951ESensor::mode_name(stats.mode));
+    }
+}
+
+void IT8951EMetrics::dump_config() {
+    ESP_LOGCONFIG(TAG, "IT8951E Metrics:");
+    LOG_SENSOR("  ", "Upload Bytes", this->upload_bytes_sensor_);
+    LOG_SENSOR("  ", "Upload Time", this->upload_time_sensor_);
+    LOG_SENSOR("  ", "Waveform Time", this->waveform_time_sensor_);
+    LOG_SENSOR("  ", "Refresh Area", this->refresh_area_sensor_);
+    LOG_TEXT_SENSOR("  ", "Refresh Mode", this->refresh_mode_text_sensor_);
+}
+
+}  // namespace it8951e
+}  // namespace esphome
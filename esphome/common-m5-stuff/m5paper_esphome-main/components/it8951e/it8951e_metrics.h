@@ -0,0 +1,34 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+#include "it8951e.h"
+
+namespace esphome {
+namespace it8951e {
+
+// Publishes the statistics of every IT8951ESensor refresh once its waveform has finished
+class IT8951EMetrics : public Component, public Parented<IT8951ESensor> {
+ public:
+  void set_upload_bytes_sensor(sensor::Sensor *sensor) { this->upload_bytes_sensor_ = sensor; }
+  void set_upload_time_sensor(sensor::Sensor *sensor) { this->upload_time_sensor_ = sensor; }
+  void set_waveform_time_sensor(sensor::Sensor *sensor) { this->waveform_time_sensor_ = sensor; }
+  void set_refresh_area_sensor(sensor::Sensor *sensor) { this->refresh_area_sensor_ = sensor; }
+  void set_refresh_mode_text_sensor(text_sensor::TextSensor *sensor) { this->refresh_mode_text_sensor_ = sensor; }
+
+  void setup() override;
+  void dump_config() override;
+
+ protected:
+  void publish_();
+
+  sensor::Sensor *upload_bytes_sensor_{nullptr};
+  sensor::Sensor *upload_time_sensor_{nullptr};
+  sensor::Sensor *waveform_time_sensor_{nullptr};
+  sensor::Sensor *refresh_area_sensor_{nullptr};
+  text_sensor::TextSensor *refresh_mode_text_sensor_{nullptr};
+};
+
+}  // namespace it8951e
+}  // namespace esphome
@@ -0,0 +1,77 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor, text_sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+    UNIT_PERCENT,
+)
+
+from .display import IT8951ESensor, it8951e_ns
+
+AUTO_LOAD = ["text_sensor"]
+
+IT8951EMetrics = it8951e_ns.class_(
+    "IT8951EMetrics", cg.Component, cg.Parented.template(IT8951ESensor)
+)
+
+CONF_DISPLAY_ID = "display_id"
+CONF_UPLOAD_BYTES = "upload_bytes"
+CONF_UPLOAD_TIME = "upload_time"
+CONF_WAVEFORM_TIME = "waveform_time"
+CONF_REFRESH_AREA = "refresh_area"
+CONF_REFRESH_MODE = "refresh_mode"
+
+UNIT_BYTES = "B"
+
+
+def _metric_schema(unit, accuracy, icon):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        accuracy_decimals=accuracy,
+        icon=icon,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+# Every value is published once per refresh, when the waveform has finished
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(IT8951EMetrics),
+        cv.GenerateID(CONF_DISPLAY_ID): cv.use_id(IT8951ESensor),
+        cv.Optional(CONF_UPLOAD_BYTES): _metric_schema(UNIT_BYTES, 0, "mdi:transfer"),
+        cv.Optional(CONF_UPLOAD_TIME): _metric_schema(UNIT_MILLISECOND, 1, "mdi:timer-outline"),
+        # From the display command until LUTAFSR reports idle, to the LUT poll interval
+        cv.Optional(CONF_WAVEFORM_TIME): _metric_schema(UNIT_MILLISECOND, 0, "mdi:timer-sand"),
+        cv.Optional(CONF_REFRESH_AREA): _metric_schema(UNIT_PERCENT, 1, "mdi:select-all"),
+        # Waveform of the largest refreshed region
+        cv.Optional(CONF_REFRESH_MODE): text_sensor.text_sensor_schema(
+            icon="mdi:waveform",
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+METRICS = {
+    CONF_UPLOAD_BYTES: "set_upload_bytes_sensor",
+    CONF_UPLOAD_TIME: "set_upload_time_sensor",
+    CONF_WAVEFORM_TIME: "set_waveform_time_sensor",
+    CONF_REFRESH_AREA: "set_refresh_area_sensor",
+}
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await cg.register_parented(var, config[CONF_DISPLAY_ID])
+
+    for key, setter in METRICS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+    if CONF_REFRESH_MODE in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_REFRESH_MODE])
+        cg.add(var.set_refresh_mode_text_sensor(sens))
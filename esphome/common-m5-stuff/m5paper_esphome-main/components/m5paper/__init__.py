@@ -1,18 +1,31 @@
 import esphome.codegen as cg
 from esphome import pins
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome import automation
 from esphome.const import (
     CONF_ID,
+    CONF_DISPLAY_ID,
+    CONF_PLATFORM,
+    CONF_SLEEP_DURATION,
+    CONF_TIMEOUT,
 )
 
 m5paper_ns = cg.esphome_ns.namespace('m5paper')
 
 M5PaperComponent = m5paper_ns.class_('M5PaperComponent', cg.Component)
 PowerAction = m5paper_ns.class_("PowerAction", automation.Action)
+RefreshThenSleepAction = m5paper_ns.class_("RefreshThenSleepAction", automation.Action)
+
+# Declared here rather than imported, so m5paper does not depend on the other components unless the action is used
+IT8951ESensor = cg.esphome_ns.namespace("it8951e").class_("IT8951ESensor")
+BM8563 = cg.esphome_ns.namespace("bm8563").class_("BM8563")
 
 CONF_MAIN_POWER_PIN = "main_power_pin"
 CONF_BATTERY_POWER_PIN = "battery_power_pin"
+CONF_RTC_ID = "rtc_id"
+CONF_FULL_UPDATE = "full_update"
+CONF_WAKE_EVERY = "wake_every"
 
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(M5PaperComponent),
@@ -20,6 +33,42 @@ CONFIG_SCHEMA = cv.Schema({
     cv.Required(CONF_BATTERY_POWER_PIN): pins.gpio_output_pin_schema
 })
 
+def _refresh_then_sleep_configs(node):
+    if isinstance(node, dict):
+        for key, value in node.items():
+            if key == "m5paper.refresh_then_sleep" and isinstance(value, dict):
+                yield value
+            else:
+                yield from _refresh_then_sleep_configs(value)
+    elif isinstance(node, list):
+        for item in node:
+            yield from _refresh_then_sleep_configs(item)
+
+
+def _final_validate(config):
+    # An RTC that can arm nothing would power down a battery device for good; the C++ side refuses then
+    full_config = fv.full_config.get()
+    rtcs = {
+        str(conf[CONF_ID]): conf
+        for conf in full_config.get("time", [])
+        if conf.get(CONF_PLATFORM) == "bm8563"
+    }
+    for action in _refresh_then_sleep_configs(full_config):
+        wake_every = action[CONF_WAKE_EVERY]
+        if cg.is_template(wake_every) or wake_every.total_minutes > 0:
+            continue
+        rtc = rtcs.get(str(action[CONF_RTC_ID]))
+        if rtc is not None and CONF_SLEEP_DURATION not in rtc:
+            raise cv.Invalid(
+                f"m5paper.refresh_then_sleep: {CONF_RTC_ID} needs {CONF_WAKE_EVERY} or a "
+                f"{CONF_SLEEP_DURATION} on the bm8563 '{action[CONF_RTC_ID]}'"
+            )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _final_validate
+
+
 @automation.register_action(
     "m5paper.shutdown_main_power",
     PowerAction,
@@ -35,6 +84,49 @@ async def m5paper_shutdown_main_power_to_code(config, action_id, template_arg, a
     return var
 
 
+@automation.register_action(
+    "m5paper.refresh_then_sleep",
+    RefreshThenSleepAction,
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.use_id(M5PaperComponent),
+            cv.Required(CONF_DISPLAY_ID): cv.use_id(IT8951ESensor),
+            # Wakes the device again; main power is only cut once its alarm or countdown is armed
+            cv.Required(CONF_RTC_ID): cv.use_id(BM8563),
+            # GC16 (updateslow) instead of the partial update
+            cv.Optional(CONF_FULL_UPDATE, default=True): cv.templatable(cv.boolean),
+            # Aligned RTC alarm, e.g. 30min wakes at :00 and :30; without it the bm8563 sleep_duration is used
+            cv.Optional(CONF_WAKE_EVERY, default="0min"): cv.templatable(cv.positive_time_period_minutes),
+            # Longest wait for the waveform before powering down anyway
+            cv.Optional(CONF_TIMEOUT, default="15s"): cv.templatable(cv.positive_time_period_milliseconds),
+        }
+    ),
+)
+async def m5paper_refresh_then_sleep_to_code(config, action_id, template_arg, args):
+    cg.add_define("USE_M5PAPER_POWER_DOWN")
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    display = await cg.get_variable(config[CONF_DISPLAY_ID])
+    cg.add(var.set_display(display))
+    rtc = await cg.get_variable(config[CONF_RTC_ID])
+    cg.add(var.set_rtc(rtc))
+    full_update = await cg.templatable(config[CONF_FULL_UPDATE], args, cg.bool_)
+    cg.add(var.set_full_update(full_update))
+    wake_every = config[CONF_WAKE_EVERY]
+    if cg.is_template(wake_every):
+        wake_every = await cg.templatable(wake_every, args, cg.uint32)
+    else:
+        wake_every = wake_every.total_minutes
+    cg.add(var.set_wake_every(wake_every))
+    timeout = config[CONF_TIMEOUT]
+    if cg.is_template(timeout):
+        timeout = await cg.templatable(timeout, args, cg.uint32)
+    else:
+        timeout = timeout.total_milliseconds
+    cg.add(var.set_timeout(timeout))
+    return var
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
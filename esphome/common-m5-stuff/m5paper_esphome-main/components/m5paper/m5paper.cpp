@@ -34,6 +34,74 @@ void M5PaperComponent::shutdown_main_power() {
     this->main_power_pin_->digital_write(false);
 }
 
+#ifdef USE_M5PAPER_POWER_DOWN
+void M5PaperComponent::refresh_then_sleep(it8951e::IT8951ESensor *display, bm8563::BM8563 *rtc, bool full_update,
+                                          uint32_t wake_every_min, uint32_t timeout_ms) {
+    if (this->powering_down_) {
+        return;
+    }
+    this->powering_down_ = true;
+    this->power_down_display_ = display;
+    this->power_down_rtc_ = rtc;
+    this->power_down_wake_every_ = wake_every_min;
+
+    if (this->callback_display_ != display) {
+        this->callback_display_ = display;
+        display->add_on_idle_callback([this, display]() {
+            if (this->powering_down_ && this->power_down_display_ == display) {
+                this->power_down_(true);
+            }
+        });
+    }
+    // A controller that never reports completion must not keep the device awake
+    this->set_timeout("power_down", timeout_ms, [this]() { this->power_down_(false); });
+
+    ESP_LOGI(TAG, "Refreshing before power down");
+    // The display going idle (also after an update that changed nothing) calls back into power_down_()
+    if (full_update) {
+        display->update_slow();
+    } else {
+        display->update();
+    }
+}
+
+void M5PaperComponent::power_down_(bool refreshed) {
+    if (!this->powering_down_) {
+        return;
+    }
+    this->cancel_timeout("power_down");
+    if (!refreshed) {
+        ESP_LOGW(TAG, "Refresh did not complete in time, powering down anyway");
+    }
+    // Already asleep after a completed refresh; the command is harmless then and needed after a timeout
+    this->power_down_display_->sleep();
+
+    bm8563::BM8563 *rtc = this->power_down_rtc_;
+    const uint32_t wake_every = this->power_down_wake_every_;
+    int seconds = -1;
+    if (wake_every > 0) {
+        seconds = rtc->apply_alarm_every(wake_every);
+        if (seconds < 0) {
+            // No valid time yet: the same period from now, unaligned
+            ESP_LOGW(TAG, "Aligned alarm not possible, waking in %u min instead", (unsigned) wake_every);
+            seconds = rtc->apply_countdown(wake_every * 60);
+        }
+    } else {
+        seconds = rtc->apply_sleep_duration();
+    }
+    if (seconds < 0) {
+        // Without main power and a wakeup a battery device would stay off until the button is pressed
+        ESP_LOGE(TAG, "No RTC wakeup could be armed, staying powered");
+        this->powering_down_ = false;
+        return;
+    }
+    ESP_LOGI(TAG, "Awake for %u ms", (unsigned) millis());
+    this->shutdown_main_power();
+    // Still running on USB power: allow the next cycle
+    this->powering_down_ = false;
+}
+#endif
+
 void M5PaperComponent::dump_config() {
     ESP_LOGCONFIG(TAG, "M5Paper");
 }
@@ -3,6 +3,12 @@
 #include "esphome/core/component.h"
 #include "esphome/core/gpio.h"
 #include "esphome/core/automation.h"
+#include "esphome/core/defines.h"
+
+#ifdef USE_M5PAPER_POWER_DOWN
+#include "esphome/components/it8951e/it8951e.h"
+#include "esphome/components/bm8563/bm8563.h"
+#endif
 
 namespace esphome {
 namespace m5paper {
@@ -18,10 +24,28 @@ public:
     void set_main_power_pin(GPIOPin *power) { this->main_power_pin_ = power; }
     void shutdown_main_power();
 
+#ifdef USE_M5PAPER_POWER_DOWN
+    // Renders, waits until the panel has really finished its waveform (at most timeout_ms), puts the controller
+    // to sleep, arms the RTC (an aligned alarm every wake_every_min minutes, or its sleep_duration if 0) and
+    // cuts main power. Stays powered if no wakeup could be armed.
+    void refresh_then_sleep(it8951e::IT8951ESensor *display, bm8563::BM8563 *rtc, bool full_update,
+                            uint32_t wake_every_min, uint32_t timeout_ms);
+#endif
+
 private:
     GPIOPin *battery_power_pin_{nullptr};
     GPIOPin *main_power_pin_{nullptr};
 
+#ifdef USE_M5PAPER_POWER_DOWN
+    void power_down_(bool refreshed);
+
+    it8951e::IT8951ESensor *power_down_display_{nullptr};
+    bm8563::BM8563 *power_down_rtc_{nullptr};
+    uint32_t power_down_wake_every_{0};
+    bool powering_down_{false};
+    // The display keeps its callbacks, so this one is only added once per display
+    it8951e::IT8951ESensor *callback_display_{nullptr};
+#endif
 };
 
 template<typename... Ts> class PowerAction : public Action<Ts...>, public Parented<M5PaperComponent> {
@@ -29,5 +53,25 @@ public:
     void play(Ts... x) override { this->parent_->shutdown_main_power(); }
 };
 
+#ifdef USE_M5PAPER_POWER_DOWN
+template<typename... Ts> class RefreshThenSleepAction : public Action<Ts...>, public Parented<M5PaperComponent> {
+public:
+    void set_display(it8951e::IT8951ESensor *display) { this->display_ = display; }
+    void set_rtc(bm8563::BM8563 *rtc) { this->rtc_ = rtc; }
+    TEMPLATABLE_VALUE(bool, full_update)
+    TEMPLATABLE_VALUE(uint32_t, wake_every)
+    TEMPLATABLE_VALUE(uint32_t, timeout)
+
+    void play(Ts... x) override {
+        this->parent_->refresh_then_sleep(this->display_, this->rtc_, this->full_update_.value(x...),
+                                          this->wake_every_.value(x...), this->timeout_.value(x...));
+    }
+
+protected:
+    it8951e::IT8951ESensor *display_{nullptr};
+    bm8563::BM8563 *rtc_{nullptr};
+};
+#endif
+
 } //namespace m5paper
 } //namespace esphome
\ No newline at end of file
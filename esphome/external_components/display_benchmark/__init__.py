@@ -0,0 +1,97 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome import automation
+from esphome.components import font, sensor
+from esphome.components.display_transport import BenchmarkTarget
+from esphome.const import (
+    CONF_DISPLAY_ID,
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+
+AUTO_LOAD = ["display_transport", "sensor"]
+
+display_benchmark_ns = cg.esphome_ns.namespace("display_benchmark")
+DisplayBenchmark = display_benchmark_ns.class_("DisplayBenchmark", cg.Component)
+RunAction = display_benchmark_ns.class_("RunAction", automation.Action, cg.Parented.template(DisplayBenchmark))
+
+CONF_FONT_ID = "font_id"
+CONF_FRAMES = "frames"
+CONF_RECTS = "rects"
+CONF_FULL_FILL = "full_fill"
+CONF_RANDOM_RECTS = "random_rects"
+CONF_TEXT_PAGE = "text_page"
+CONF_THROUGHPUT = "throughput"
+CONF_TRANSACTIONS = "transactions"
+
+UNIT_BYTES_PER_SECOND = "B/s"
+
+
+def _result_schema(unit, accuracy, icon):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        accuracy_decimals=accuracy,
+        icon=icon,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+# Results are published once per run (display_benchmark.run)
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(DisplayBenchmark),
+        # Any display that implements display_transport::BenchmarkTarget (gc9a01_display, it8951e)
+        cv.Required(CONF_DISPLAY_ID): cv.use_id(BenchmarkTarget),
+        # Without a font the text page is skipped
+        cv.Optional(CONF_FONT_ID): cv.use_id(font.Font),
+        cv.Optional(CONF_FRAMES, default=5): cv.int_range(min=1, max=1000),
+        cv.Optional(CONF_RECTS, default=16): cv.int_range(min=1, max=1000),
+        # Milliseconds per frame, drawing and flushing (e-paper: including the waveform)
+        cv.Optional(CONF_FULL_FILL): _result_schema(UNIT_MILLISECOND, 1, "mdi:timer-outline"),
+        cv.Optional(CONF_RANDOM_RECTS): _result_schema(UNIT_MILLISECOND, 1, "mdi:timer-outline"),
+        cv.Optional(CONF_TEXT_PAGE): _result_schema(UNIT_MILLISECOND, 1, "mdi:timer-outline"),
+        # SPI write traffic over the whole suite
+        cv.Optional(CONF_THROUGHPUT): _result_schema(UNIT_BYTES_PER_SECOND, 0, "mdi:transfer"),
+        cv.Optional(CONF_TRANSACTIONS): _result_schema("", 1, "mdi:swap-horizontal"),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+RESULTS = {
+    CONF_FULL_FILL: "set_full_fill_sensor",
+    CONF_RANDOM_RECTS: "set_random_rects_sensor",
+    CONF_TEXT_PAGE: "set_text_page_sensor",
+    CONF_THROUGHPUT: "set_throughput_sensor",
+    CONF_TRANSACTIONS: "set_transactions_sensor",
+}
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    disp = await cg.get_variable(config[CONF_DISPLAY_ID])
+    cg.add(var.set_display(disp))
+    if CONF_FONT_ID in config:
+        fnt = await cg.get_variable(config[CONF_FONT_ID])
+        cg.add(var.set_font(fnt))
+    cg.add(var.set_frames(config[CONF_FRAMES]))
+    cg.add(var.set_rects(config[CONF_RECTS]))
+
+    for key, setter in RESULTS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+
+
+@automation.register_action(
+    "display_benchmark.run",
+    RunAction,
+    automation.maybe_simple_id({cv.GenerateID(): cv.use_id(DisplayBenchmark)}),
+)
+async def run_to_code(config, action_id, template_arg, args):
+    var = cg.new_Pvariable(action_id, template_arg)
+    await cg.register_parented(var, config[CONF_ID])
+    return var
@@ -0,0 +1,209 @@
+#include "display_benchmark.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+
+namespace esphome
+{
+    namespace display_benchmark
+    {
+
+        static const char *const TAG = "display_benchmark";
+
+        static const char *const TEST_NAMES[TEST_COUNT] = {"Full fill", "Random rectangles", "Text page"};
+        // Same sequence on every run, so results can be compared between firmware builds
+        static const uint32_t RANDOM_SEED = 0x2545F491;
+        static const char *const TEXT_LINE = "The quick brown fox jumps over the lazy dog 0123456789";
+
+        void DisplayBenchmark::start()
+        {
+            if (this->is_running())
+            {
+                ESP_LOGW(TAG, "Benchmark already running");
+                return;
+            }
+            ESP_LOGI(TAG, "Running the display benchmark, %u frames per test", this->frames_);
+            for (BenchmarkResult &result : this->results_)
+                result = BenchmarkResult{};
+            this->high_freq_.start();
+            this->start_test_(TEST_FULL_FILL);
+        }
+
+        void DisplayBenchmark::loop()
+        {
+            if (!this->is_running())
+                return;
+            // An ASYNC frame or e-paper refresh belongs to the frame before; it counts towards this test
+            if (this->target_->benchmark_busy())
+                return;
+            if (this->frame_ == this->frames_)
+            {
+                this->finish_test_();
+                return;
+            }
+            this->draw_frame_();
+            this->target_->benchmark_flush();
+            this->frame_++;
+        }
+
+        void DisplayBenchmark::start_test_(uint8_t test)
+        {
+            // Tests without what they need are skipped and keep frames == 0
+            while (test == TEST_TEXT_PAGE && this->font_ == nullptr)
+            {
+                ESP_LOGD(TAG, "No font, skipping the text page");
+                test++;
+            }
+            this->test_ = test;
+            if (test >= TEST_COUNT)
+            {
+                this->finish_suite_();
+                return;
+            }
+            this->frame_ = 0;
+            this->rng_ = RANDOM_SEED;
+            this->test_start_us_ = micros();
+            this->test_start_bytes_ = this->counted_bytes_();
+            this->test_start_transactions_ = this->counted_transactions_();
+        }
+
+        void DisplayBenchmark::finish_test_()
+        {
+            BenchmarkResult &result = this->results_[this->test_];
+            result.frames = this->frames_;
+            result.elapsed_us = micros() - this->test_start_us_;
+            result.bytes = this->counted_bytes_() - this->test_start_bytes_;
+            result.transactions = this->counted_transactions_() - this->test_start_transactions_;
+            ESP_LOGI(TAG, "%s: %.1f ms/frame, %" PRIu32 " bytes, %" PRIu32 " transactions", TEST_NAMES[this->test_],
+                     result.elapsed_us / 1000.0f / result.frames, result.bytes, result.transactions);
+            this->start_test_(this->test_ + 1);
+        }
+
+        void DisplayBenchmark::finish_suite_()
+        {
+            this->high_freq_.stop();
+            uint64_t elapsed_us = 0;
+            uint32_t bytes = 0, transactions = 0, frames = 0;
+            for (uint8_t test = 0; test < TEST_COUNT; test++)
+            {
+                const BenchmarkResult &result = this->results_[test];
+                if (result.frames == 0)
+                    continue;
+                elapsed_us += result.elapsed_us;
+                bytes += result.bytes;
+                transactions += result.transactions;
+                frames += result.frames;
+                if (this->test_sensors_[test] != nullptr)
+                    this->test_sensors_[test]->publish_state(result.elapsed_us / 1000.0f / result.frames);
+            }
+            // Without a transport the byte and transaction counts stay 0 and are not published
+            if (this->target_->benchmark_transport() != nullptr && frames > 0)
+            {
+                if (this->throughput_sensor_ != nullptr && elapsed_us > 0)
+                    this->throughput_sensor_->publish_state(bytes * 1e6f / elapsed_us);
+                if (this->transactions_sensor_ != nullptr)
+                    this->transactions_sensor_->publish_state(float(transactions) / frames);
+            }
+            ESP_LOGI(TAG, "Benchmark done");
+            // Back to the normal page
+            this->display_->update();
+        }
+
+        void DisplayBenchmark::draw_frame_()
+        {
+            switch (this->test_)
+            {
+            case TEST_FULL_FILL:
+                this->display_->fill(this->frame_ & 1 ? Color::WHITE : Color::BLACK);
+                break;
+            case TEST_RANDOM_RECTS:
+                this->draw_random_rects_();
+                break;
+            case TEST_TEXT_PAGE:
+                this->draw_text_page_();
+                break;
+            default:
+                break;
+            }
+        }
+
+        void DisplayBenchmark::draw_random_rects_()
+        {
+            // Rectangles of 1/16 to 1/4 of the screen size, partly off screen at the right and bottom edges
+            const int width = this->display_->get_width();
+            const int height = this->display_->get_height();
+            for (uint16_t i = 0; i < this->rects_; i++)
+            {
+                const int x = this->random_() % width;
+                const int y = this->random_() % height;
+                const int w = width / 16 + this->random_() % (width / 4);
+                const int h = height / 16 + this->random_() % (height / 4);
+                const uint32_t rgb = this->random_();
+                this->display_->filled_rectangle(x, y, w, h, Color(rgb >> 16, rgb >> 8, rgb));
+            }
+        }
+
+        void DisplayBenchmark::draw_text_page_()
+        {
+            // Inverted on every frame, so each one replaces the whole screen
+            const bool inverted = this->frame_ & 1;
+            const Color background = inverted ? Color::BLACK : Color::WHITE;
+            const Color foreground = inverted ? Color::WHITE : Color::BLACK;
+            this->display_->fill(background);
+
+            int width, x_offset, baseline, height;
+            this->font_->measure(TEXT_LINE, &width, &x_offset, &baseline, &height);
+            if (height <= 0)
+                return;
+            char line[80];
+            for (int y = 0, row = 0; y + height <= this->display_->get_height(); y += height, row++)
+            {
+                snprintf(line, sizeof(line), "%02d %s", row, TEXT_LINE);
+                this->display_->print(0, y, this->font_, foreground, line);
+            }
+        }
+
+        uint32_t DisplayBenchmark::random_()
+        {
+            // xorshift32
+            uint32_t x = this->rng_;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            this->rng_ = x;
+            return x;
+        }
+
+        uint32_t DisplayBenchmark::counted_bytes_() const
+        {
+            const display_transport::SPIDisplayTransport *transport = this->target_->benchmark_transport();
+            if (transport == nullptr)
+                return 0;
+            const display_transport::TransportCounters &counters = transport->get_transport_counters();
+            return counters.control_bytes + counters.data_bytes;
+        }
+
+        uint32_t DisplayBenchmark::counted_transactions_() const
+        {
+            const display_transport::SPIDisplayTransport *transport = this->target_->benchmark_transport();
+            return transport != nullptr ? transport->get_transport_counters().transactions : 0;
+        }
+
+        void DisplayBenchmark::dump_config()
+        {
+            ESP_LOGCONFIG(TAG, "Display Benchmark:");
+            ESP_LOGCONFIG(TAG, "  Frames per test: %u", this->frames_);
+            ESP_LOGCONFIG(TAG, "  Rectangles per frame: %u", this->rects_);
+            ESP_LOGCONFIG(TAG, "  Text page: %s", YESNO(this->font_ != nullptr));
+            LOG_SENSOR("  ", "Full Fill", this->test_sensors_[TEST_FULL_FILL]);
+            LOG_SENSOR("  ", "Random Rectangles", this->test_sensors_[TEST_RANDOM_RECTS]);
+            LOG_SENSOR("  ", "Text Page", this->test_sensors_[TEST_TEXT_PAGE]);
+            LOG_SENSOR("  ", "Throughput", this->throughput_sensor_);
+            LOG_SENSOR("  ", "Transactions", this->transactions_sensor_);
+        }
+
+    } // namespace display_benchmark
+} // namespace esphome
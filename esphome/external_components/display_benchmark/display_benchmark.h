@@ -0,0 +1,105 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/helpers.h"
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/display_transport/display_transport.h"
+
+namespace esphome
+{
+    namespace display_benchmark
+    {
+
+        // The standard suite, run in this order
+        enum BenchmarkTest : uint8_t
+        {
+            TEST_FULL_FILL = 0,    // The whole screen, alternating black and white
+            TEST_RANDOM_RECTS = 1, // Filled rectangles of random size and color
+            TEST_TEXT_PAGE = 2,    // A screen full of text lines (needs a font)
+            TEST_COUNT = 3,
+        };
+
+        // Result of one test; transport figures are deltas of the display's TransportCounters
+        struct BenchmarkResult
+        {
+            uint16_t frames{0};
+            uint32_t elapsed_us{0};
+            uint32_t bytes{0}; // Control and pixel bytes
+            uint32_t transactions{0};
+        };
+
+        // Draws the suite on a display that implements display_transport::BenchmarkTarget. Frames are drawn and
+        // flushed from loop(), waiting out ASYNC frames and e-paper refreshes in between, so the rest of the
+        // firmware keeps running. Give the display update_interval: never, or its own updates are measured too.
+        class DisplayBenchmark : public Component
+        {
+        public:
+            // Any display class that derives from both DisplayBuffer and BenchmarkTarget
+            template<typename T> void set_display(T *display)
+            {
+                this->display_ = display;
+                this->target_ = display;
+            }
+            void set_font(display::BaseFont *font) { this->font_ = font; }
+            void set_frames(uint16_t frames) { this->frames_ = frames; }
+            void set_rects(uint16_t rects) { this->rects_ = rects; }
+
+            // Milliseconds per frame of each test
+            void set_full_fill_sensor(sensor::Sensor *sensor) { this->test_sensors_[TEST_FULL_FILL] = sensor; }
+            void set_random_rects_sensor(sensor::Sensor *sensor) { this->test_sensors_[TEST_RANDOM_RECTS] = sensor; }
+            void set_text_page_sensor(sensor::Sensor *sensor) { this->test_sensors_[TEST_TEXT_PAGE] = sensor; }
+            // Bytes per second and transactions per frame over the whole suite
+            void set_throughput_sensor(sensor::Sensor *sensor) { this->throughput_sensor_ = sensor; }
+            void set_transactions_sensor(sensor::Sensor *sensor) { this->transactions_sensor_ = sensor; }
+
+            // Starts the suite; ignored while it is already running
+            void start();
+            bool is_running() const { return this->test_ < TEST_COUNT; }
+            const BenchmarkResult &get_result(BenchmarkTest test) const { return this->results_[test]; }
+
+            void loop() override;
+            void dump_config() override;
+            float get_setup_priority() const override { return setup_priority::PROCESSOR; }
+
+        protected:
+            void start_test_(uint8_t test);
+            void finish_test_();
+            void finish_suite_();
+            void draw_frame_();
+            void draw_random_rects_();
+            void draw_text_page_();
+            uint32_t random_();
+            uint32_t counted_bytes_() const;
+            uint32_t counted_transactions_() const;
+
+            display::DisplayBuffer *display_{nullptr};
+            display_transport::BenchmarkTarget *target_{nullptr};
+            display::BaseFont *font_{nullptr};
+            uint16_t frames_{5};
+            uint16_t rects_{16};
+
+            sensor::Sensor *test_sensors_[TEST_COUNT]{};
+            sensor::Sensor *throughput_sensor_{nullptr};
+            sensor::Sensor *transactions_sensor_{nullptr};
+
+            uint8_t test_{TEST_COUNT}; // Running test, TEST_COUNT when idle
+            uint16_t frame_{0};
+            uint32_t test_start_us_{0};
+            uint32_t test_start_bytes_{0};
+            uint32_t test_start_transactions_{0};
+            uint32_t rng_{0};
+            BenchmarkResult results_[TEST_COUNT]{};
+            // Runs loop() without the usual idle delay, so a finished frame is noticed at once
+            HighFrequencyLoopRequester high_freq_;
+        };
+
+        template<typename... Ts> class RunAction : public Action<Ts...>, public Parented<DisplayBenchmark>
+        {
+        public:
+            void play(Ts... x) override { this->parent_->start(); }
+        };
+
+    } // namespace display_benchmark
+} // namespace esphome
@@ -0,0 +1,9 @@
+import esphome.codegen as cg
+
+# Shared SPI transport of the display drivers. It has no configuration of its own:
+# drivers pull it in with AUTO_LOAD = ["display_transport"]. The one copy lives here;
+# configs with it8951e list this directory as an external_components source as well
+
+display_transport_ns = cg.esphome_ns.namespace("display_transport")
+SPIDisplayTransport = display_transport_ns.class_("SPIDisplayTransport")
+BenchmarkTarget = display_transport_ns.class_("BenchmarkTarget")
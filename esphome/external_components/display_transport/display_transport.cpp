@@ -0,0 +1,113 @@
+#include "display_transport.h"
+
+#include <cstdlib>
+
+#ifdef USE_ESP32
+#include <esp_heap_caps.h>
+#endif
+
+namespace esphome
+{
+    namespace display_transport
+    {
+
+        void SPIDisplayTransport::send_command_(uint8_t cmd, const uint8_t *args, size_t length)
+        {
+            // DC must be stable before CS is asserted, and is switched to data mode after the command byte.
+            // The command and all of its parameters share one CS-asserted transaction.
+            this->transport_dc_pin_->digital_write(false);
+            this->transport_enable_();
+            this->transport_write_(&cmd, 1);
+            if (length > 0)
+            {
+                this->transport_dc_pin_->digital_write(true);
+                this->transport_write_(args, length);
+            }
+            this->transport_disable_();
+            this->transport_counters_.transactions++;
+            this->transport_counters_.control_bytes += 1 + length;
+        }
+
+        void SPIDisplayTransport::send_command16_(uint16_t cmd, const uint16_t *args, size_t count)
+        {
+            this->transport_wait_ready_();
+            this->transport_enable_();
+            this->transport_word_(this->transport_command_preamble_);
+            this->transport_word_(cmd);
+            this->transport_disable_();
+            this->transport_counters_.transactions++;
+            this->transport_counters_.control_bytes += 4;
+            if (count > 0)
+                this->send_words_(args, count);
+        }
+
+        void SPIDisplayTransport::send_words_(const uint16_t *words, size_t count)
+        {
+            // One data preamble for all words, instead of one transaction per word. Once the controller is ready
+            // behind the preamble the words are written big endian in blocks, like pixel data in a stream.
+            this->transport_wait_ready_();
+            this->transport_enable_();
+            this->transport_word_(this->transport_data_preamble_);
+            this->transport_wait_ready_();
+            uint8_t staged[TRANSPORT_STAGED_WORDS * 2];
+            for (size_t i = 0; i < count;)
+            {
+                size_t used = 0;
+                for (; i < count && used < sizeof(staged); i++)
+                {
+                    staged[used++] = words[i] >> 8;
+                    staged[used++] = words[i] & 0xFF;
+                }
+                this->transport_write_(staged, used);
+            }
+            this->transport_disable_();
+            this->transport_counters_.transactions++;
+            this->transport_counters_.control_bytes += 2 + count * 2;
+        }
+
+        void SPIDisplayTransport::begin_stream_()
+        {
+            if (this->transport_framing_ == FRAMING_DC_PIN)
+            {
+                this->transport_dc_pin_->digital_write(true);
+                this->transport_enable_();
+            }
+            else
+            {
+                this->transport_wait_ready_();
+                this->transport_enable_();
+                this->transport_word_(this->transport_data_preamble_);
+                this->transport_wait_ready_();
+                this->transport_counters_.control_bytes += 2;
+            }
+            this->transport_counters_.transactions++;
+            this->transport_counters_.streams++;
+        }
+
+        uint8_t *SPIDisplayTransport::allocate_transport_buffer_(size_t size)
+        {
+#ifdef USE_ESP32
+            // The ESP-IDF SPI master sends DMA-capable buffers directly and copies everything else
+            // through a bounce buffer first; fall back to any byte-addressable RAM if there is no room
+            void *buffer = nullptr;
+            if (this->transport_dma_)
+                buffer = heap_caps_malloc(size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+            if (buffer == nullptr)
+                buffer = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+            return static_cast<uint8_t *>(buffer);
+#else
+            return static_cast<uint8_t *>(malloc(size)); // NOLINT
+#endif
+        }
+
+        void SPIDisplayTransport::free_transport_buffer_(uint8_t *buffer)
+        {
+#ifdef USE_ESP32
+            heap_caps_free(buffer);
+#else
+            free(buffer); // NOLINT
+#endif
+        }
+
+    } // namespace display_transport
+} // namespace esphome
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "esphome/core/gpio.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome
+{
+    namespace display_transport
+    {
+
+        // Preamble framing: argument words staged per write, so they go out without a ready wait per word
+        static const size_t TRANSPORT_STAGED_WORDS = 16;
+
+        // Write traffic since the last reset_transport_counters(); reads (IDs, RAMRD, status) are not counted
+        struct TransportCounters
+        {
+            uint32_t transactions{0};  // CS-asserted transactions
+            uint32_t control_bytes{0}; // Commands, parameters and preambles
+            uint32_t data_bytes{0};    // Pixel data sent with stream_()
+            uint32_t streams{0};       // begin_stream_() .. end_stream_() bursts
+        };
+
+        // How commands and data are told apart on the bus
+        enum TransportFraming
+        {
+            FRAMING_DC_PIN = 0,   // DC low for the command byte, high for parameters and pixels (MIPI DBI panels)
+            FRAMING_PREAMBLE = 1, // Every transaction starts with a 16-bit preamble word (IT8951)
+        };
+
+        // Common SPI write path of the display drivers: one transaction per command together with all of its
+        // parameters, long pixel bursts, staging buffers that the SPI driver can send by DMA, and counters for
+        // the benchmark and metrics. The driver owns the SPI device and supplies the bus access below.
+        class SPIDisplayTransport
+        {
+        public:
+            virtual ~SPIDisplayTransport() = default;
+
+            const TransportCounters &get_transport_counters() const { return this->transport_counters_; }
+            void reset_transport_counters() { this->transport_counters_ = TransportCounters{}; }
+
+            // Staging buffers in DMA-capable internal RAM, so large writes go out without a bounce copy
+            void set_transport_dma(bool dma) { this->transport_dma_ = dma; }
+            bool get_transport_dma() const { return this->transport_dma_; }
+
+        protected:
+            void set_transport_dc_pin(GPIOPin *dc_pin)
+            {
+                this->transport_framing_ = FRAMING_DC_PIN;
+                this->transport_dc_pin_ = dc_pin;
+            }
+            void set_transport_preambles(uint16_t command, uint16_t data)
+            {
+                this->transport_framing_ = FRAMING_PREAMBLE;
+                this->transport_command_preamble_ = command;
+                this->transport_data_preamble_ = data;
+            }
+
+            // DC framing: command byte and parameters in one transaction
+            void send_command_(uint8_t cmd, const uint8_t *args = nullptr, size_t length = 0);
+            // Preamble framing: the command word in one transaction, then all arguments behind a single
+            // data preamble in a second one
+            void send_command16_(uint16_t cmd, const uint16_t *args = nullptr, size_t count = 0);
+            // Preamble framing: data words in one transaction, staged and written together after one ready wait
+            void send_words_(const uint16_t *words, size_t count);
+
+            // Pixel burst: begin_stream_() selects the panel in data mode, stream_() may be called any number
+            // of times, end_stream_() releases it
+            void begin_stream_();
+            void stream_(const uint8_t *data, size_t length)
+            {
+                this->transport_write_(data, length);
+                this->transport_counters_.data_bytes += length;
+            }
+            void end_stream_() { this->transport_disable_(); }
+
+            // Buffer for stream_(): DMA-capable with set_transport_dma(true), otherwise from the normal heap.
+            // nullptr if neither has room.
+            uint8_t *allocate_transport_buffer_(size_t size);
+            void free_transport_buffer_(uint8_t *buffer);
+
+            // Bus access of the driver
+            virtual void transport_enable_() = 0;
+            virtual void transport_disable_() = 0;
+            virtual void transport_write_(const uint8_t *data, size_t length) = 0;
+            // Preamble framing: called before every word, e.g. to wait for a host ready line
+            virtual void transport_wait_ready_() {}
+
+            void transport_word_(uint16_t word)
+            {
+                const uint8_t bytes[2] = {uint8_t(word >> 8), uint8_t(word & 0xFF)};
+                this->transport_wait_ready_();
+                this->transport_write_(bytes, sizeof(bytes));
+            }
+
+            TransportFraming transport_framing_{FRAMING_DC_PIN};
+            GPIOPin *transport_dc_pin_{nullptr};
+            uint16_t transport_command_preamble_{0};
+            uint16_t transport_data_preamble_{0};
+            bool transport_dma_{true};
+            TransportCounters transport_counters_{};
+        };
+
+        // Implemented by displays that the display_benchmark component can drive
+        class BenchmarkTarget
+        {
+        public:
+            virtual ~BenchmarkTarget() = default;
+
+            // Sends everything drawn since the last call to the panel
+            virtual void benchmark_flush() = 0;
+            // True while the last flush is still going out (ASYNC frame, e-paper refresh)
+            virtual bool benchmark_busy() = 0;
+            // Transport whose counters are reported, nullptr if there is none
+            virtual SPIDisplayTransport *benchmark_transport() = 0;
+        };
+
+    } // namespace display_transport
+} // namespace esphome
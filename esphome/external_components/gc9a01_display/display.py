@@ -1,6 +1,7 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import display, spi
+from esphome.components.display_transport import BenchmarkTarget
 from esphome import pins
 from esphome.const import (
     CONF_ID,
@@ -10,13 +11,21 @@ from esphome.const import (
 
 CODEOWNERS = ["@AndrewCraigie"]
 DEPENDENCIES = ["spi"]
+AUTO_LOAD = ["display_transport"]
 
 gc9a01a_ns = cg.esphome_ns.namespace("gc9a01a_display")
-GC9A01A = gc9a01a_ns.class_("GC9A01ADisplay", spi.SPIDevice, display.DisplayBuffer)
+GC9A01A = gc9a01a_ns.class_("GC9A01ADisplay", spi.SPIDevice, display.DisplayBuffer, BenchmarkTarget)
 
 CONF_DC_PIN = "dc_pin"
 CONF_RESET_PIN = "reset_pin"
 CONF_BACKLIGHT_PIN = "backlight_pin"
+CONF_TRANSPORT = "transport"
+CONF_FRAMEBUFFER = "framebuffer"
+CONF_PIXEL_MODE = "pixel_mode"
+CONF_BUFFER_FORMAT = "buffer_format"
+CONF_AUTO_TUNE_DATA_RATE = "auto_tune_data_rate"
+CONF_SKIP_UNCHANGED = "skip_unchanged"
+CONF_DMA = "dma"
 
 GC9A01A_MODEL = "GC9A01A"
 
@@ -24,6 +33,24 @@ MODELS = {
     GC9A01A_MODEL: GC9A01A,
 }
 
+TransportMode = gc9a01a_ns.enum("TransportMode")
+TRANSPORT_MODES = {
+    "BLOCKING": TransportMode.TRANSPORT_BLOCKING,
+    "ASYNC": TransportMode.TRANSPORT_ASYNC,
+}
+
+PixelMode = gc9a01a_ns.enum("PixelMode")
+PIXEL_MODES = {
+    "RGB565": PixelMode.PIXEL_MODE_RGB565,
+    "RGB666": PixelMode.PIXEL_MODE_RGB666,
+}
+
+BufferFormat = gc9a01a_ns.enum("BufferFormat")
+BUFFER_FORMATS = {
+    "RGB565": BufferFormat.BUFFER_FORMAT_RGB565,
+    "INDEXED8": BufferFormat.BUFFER_FORMAT_INDEXED8,
+}
+
 # The GC9A01A display requires a CS (Chip Select) pin for proper SPI communication.
 # Without this, ESPHome wouldn't enforce CS pin configuration in the YAML,
 # leading to potential communication failures.
@@ -34,9 +61,25 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_DC_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_RESET_PIN): pins.gpio_output_pin_schema,
             cv.Optional(CONF_BACKLIGHT_PIN): pins.gpio_output_pin_schema,
+            # ASYNC streams each frame from loop() in time-bounded strips so the main loop stays responsive
+            cv.Optional(CONF_TRANSPORT, default="BLOCKING"): cv.enum(TRANSPORT_MODES, upper=True),
+            # LVGL keeps its own draw buffers; without a framebuffer its flushes go straight to the panel
+            cv.Optional(CONF_FRAMEBUFFER, default=True): cv.boolean,
+            # Format on the SPI interface; RGB666 sends 3 bytes per pixel
+            cv.Optional(CONF_PIXEL_MODE, default="RGB565"): cv.enum(PIXEL_MODES, upper=True),
+            # INDEXED8 halves the framebuffer to 57.6 KB (up to 256 colors on screen), so it fits in internal RAM
+            cv.Optional(CONF_BUFFER_FORMAT, default="RGB565"): cv.enum(BUFFER_FORMATS, upper=True),
+            # Steps the SPI clock up from data_rate at boot and keeps the highest rate that reads back intact
+            # (RAMRD, needs MISO wired) if it also passes a longer confirming run, otherwise the step below
+            cv.Optional(CONF_AUTO_TUNE_DATA_RATE, default=False): cv.boolean,
+            # Hashes dirty tiles before a flush and skips the ones the panel already shows
+            cv.Optional(CONF_SKIP_UNCHANGED, default=True): cv.boolean,
+            # Staging strip in DMA-capable internal RAM, so the SPI driver sends it without a bounce copy
+            cv.Optional(CONF_DMA, default=True): cv.boolean,
         }
     )
-    .extend(spi.spi_device_schema(cs_pin_required=True)),
+    # data_rate: many modules run at 80MHz on short traces
+    .extend(spi.spi_device_schema(cs_pin_required=True, default_data_rate="40MHz")),
     cv.has_at_most_one_key(CONF_PAGES, CONF_LAMBDA),
 )
 
@@ -50,6 +93,12 @@ async def to_code(config):
     # Register as display (this will also register as component)
     await display.register_display(var, config)
 
+    if CONF_LAMBDA in config:
+        lambda_ = await cg.process_lambda(
+            config[CONF_LAMBDA], [(display.DisplayRef, "it")], return_type=cg.void
+        )
+        cg.add(var.set_writer(lambda_))
+
     dc = await cg.gpio_pin_expression(config[CONF_DC_PIN])
     cg.add(var.set_dc_pin(dc))
 
@@ -59,4 +108,12 @@ async def to_code(config):
 
     if CONF_BACKLIGHT_PIN in config:
         backlight = await cg.gpio_pin_expression(config[CONF_BACKLIGHT_PIN])
-        cg.add(var.set_backlight_pin(backlight))
\ No newline at end of file
+        cg.add(var.set_backlight_pin(backlight))
+
+    cg.add(var.set_transport_mode(config[CONF_TRANSPORT]))
+    cg.add(var.set_use_framebuffer(config[CONF_FRAMEBUFFER]))
+    cg.add(var.set_pixel_mode(config[CONF_PIXEL_MODE]))
+    cg.add(var.set_buffer_format(config[CONF_BUFFER_FORMAT]))
+    cg.add(var.set_auto_tune_data_rate(config[CONF_AUTO_TUNE_DATA_RATE]))
+    cg.add(var.set_skip_unchanged(config[CONF_SKIP_UNCHANGED]))
+    cg.add(var.set_transport_dma(config[CONF_DMA]))
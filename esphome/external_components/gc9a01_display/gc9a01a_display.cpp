@@ -2,6 +2,10 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/color.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace esphome
 {
@@ -9,6 +13,101 @@ namespace esphome
     {
 
         static const char *const TAG = "gc9a01a_display";
+
+        // Init sequence: {command, number of parameters, parameters..., delay in ms after the command}
+        static const uint8_t GC9A01A_INIT_END = 0x00;
+        static constexpr uint8_t GC9A01A_INIT_SEQUENCE[] = {
+            // Software reset, then sleep out
+            GC9A01A_SWRESET, 0, 120,
+            GC9A01A_SLPOUT, 0, 120,
+            // Memory access control: BGR color order (COLMOD is sent from the configured pixel mode afterwards)
+            GC9A01A_MADCTL, 1, GC9A01A_MADCTL_BGR, 0,
+            // GC9A01A specific initialization sequence (inter register enable, power, gamma, timing)
+            0xEF, 0, 0,
+            0xEB, 1, 0x14, 0,
+            0xFE, 0, 0,
+            0xEF, 0, 0,
+            0xEB, 1, 0x14, 0,
+            0x84, 1, 0x40, 0,
+            0x85, 1, 0xFF, 0,
+            0x86, 1, 0xFF, 0,
+            0x87, 1, 0xFF, 0,
+            0x88, 1, 0x0A, 0,
+            0x89, 1, 0x21, 0,
+            0x8A, 1, 0x00, 0,
+            0x8B, 1, 0x80, 0,
+            0x8C, 1, 0x01, 0,
+            0x8D, 1, 0x01, 0,
+            0x8E, 1, 0xFF, 0,
+            0x8F, 1, 0xFF, 0,
+            0xB6, 2, 0x00, 0x20, 0,
+            GC9A01A_MADCTL, 1, GC9A01A_MADCTL_BGR, 0,
+            0x90, 4, 0x08, 0x08, 0x08, 0x08, 0,
+            0xBD, 1, 0x06, 0,
+            0xBC, 1, 0x00, 0,
+            0xFF, 3, 0x60, 0x01, 0x04, 0,
+            0xC3, 1, 0x13, 0,
+            0xC4, 1, 0x13, 0,
+            0xC9, 1, 0x22, 0,
+            0xBE, 1, 0x11, 0,
+            0xE1, 2, 0x10, 0x0E, 0,
+            0xDF, 3, 0x21, 0x0C, 0x02, 0,
+            0xF0, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A, 0,
+            0xF1, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F, 0,
+            0xF2, 6, 0x45, 0x09, 0x08, 0x08, 0x26, 0x2A, 0,
+            0xF3, 6, 0x43, 0x70, 0x72, 0x36, 0x37, 0x6F, 0,
+            0xED, 2, 0x1B, 0x0B, 0,
+            0xAE, 1, 0x77, 0,
+            0xCD, 1, 0x63, 0,
+            0x70, 9, 0x07, 0x07, 0x04, 0x0E, 0x0F, 0x09, 0x07, 0x08, 0x03, 0,
+            0xE8, 1, 0x34, 0,
+            0x62, 12, 0x18, 0x0D, 0x71, 0xED, 0x70, 0x70, 0x18, 0x0F, 0x71, 0xEF, 0x70, 0x70, 0,
+            0x63, 12, 0x18, 0x11, 0x71, 0xF1, 0x70, 0x70, 0x18, 0x13, 0x71, 0xF3, 0x70, 0x70, 0,
+            0x64, 7, 0x28, 0x29, 0xF1, 0x01, 0xF1, 0x00, 0x07, 0,
+            0x66, 10, 0x3C, 0x00, 0xCD, 0x67, 0x45, 0x45, 0x10, 0x00, 0x00, 0x00, 0,
+            0x67, 10, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x01, 0x54, 0x10, 0x32, 0x98, 0,
+            0x74, 7, 0x10, 0x85, 0x80, 0x00, 0x00, 0x4E, 0x00, 0,
+            0x98, 2, 0x3E, 0x07, 0,
+            // Display inversion on, normal display mode on, display on
+            GC9A01A_INVON, 0, 10,
+            GC9A01A_NORON, 0, 10,
+            GC9A01A_DISPON, 0, 120,
+            GC9A01A_INIT_END, // End of sequence
+        };
+
+        // Visible part of the round glass: per-row chord of pixel centres inside the 240 px circle,
+        // plus the tiles touched by it. Computed at compile time in doubled coordinates to stay in integers.
+        struct RoundMask
+        {
+            uint8_t start[GC9A01A_HEIGHT];
+            uint8_t end[GC9A01A_HEIGHT];
+            uint16_t tiles[GC9A01A_TILE_ROWS];
+        };
+
+        static constexpr RoundMask make_round_mask()
+        {
+            RoundMask mask{};
+            const int32_t diameter2 = int32_t(GC9A01A_WIDTH) * GC9A01A_WIDTH;
+            for (int32_t y = 0; y < GC9A01A_HEIGHT; y++)
+            {
+                const int32_t dy = 2 * y + 1 - GC9A01A_HEIGHT;
+                int32_t x = GC9A01A_WIDTH - 1;
+                while (x > GC9A01A_WIDTH / 2 && (2 * x + 1 - GC9A01A_WIDTH) * (2 * x + 1 - GC9A01A_WIDTH) + dy * dy > diameter2)
+                    x--;
+                const int32_t start = GC9A01A_WIDTH - 1 - x;
+                mask.start[y] = start;
+                mask.end[y] = x;
+                mask.tiles[y / GC9A01A_TILE_SIZE] |= ((1 << (x / GC9A01A_TILE_SIZE + 1)) - 1) & ~((1 << (start / GC9A01A_TILE_SIZE)) - 1);
+            }
+            return mask;
+        }
+
+        static constexpr RoundMask GC9A01A_ROUND_MASK = make_round_mask();
+
+        // Clock rates tried by the calibration, in ascending order. The SPI clock is divided down from
+        // the 80 MHz APB clock, so these are the rates the controller can actually produce.
+        static const uint32_t GC9A01A_TUNE_RATES[] = {20000000, 26666666, 40000000, 80000000};
+
         void GC9A01ADisplay::setup()
         {
 
@@ -24,6 +123,7 @@ namespace esphome
             // Without this call, the pin remains unconfigured and digital_write() will fail
             // See: ESP32InternalGPIOPin::setup() -> gpio_config() for hardware initialization
             this->dc_pin_->setup();
+            this->set_transport_dc_pin(this->dc_pin_);
 
             // Explicitly setup backlight pin if provided
             // This is optional, but recommended for displays with backlight control
@@ -35,13 +135,45 @@ namespace esphome
 
             // Initialize display
             this->init_display_();
+            this->read_id_();
+            if (this->auto_tune_data_rate_)
+            {
+                this->tune_data_rate_();
+            }
+
+            // Off-screen framebuffer: big-endian RGB565, so rows can be streamed to RAMWR as-is, or palette
+            // indices that are expanded while flushing. INDEXED8 is half the size and fits in internal RAM.
+            // Without it (disabled for LVGL, or allocation failed) pixels are written straight to the panel
+            if (this->use_framebuffer_)
+            {
+                this->init_internal_(GC9A01A_WIDTH * GC9A01A_HEIGHT * this->buffer_bytes_());
+                if (this->buffer_ == nullptr)
+                {
+                    ESP_LOGW(TAG, "No framebuffer, drawing directly to the panel");
+                }
+                else if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+                {
+                    this->palette_ = new uint16_t[GC9A01A_PALETTE_SIZE];
+                    this->palette_slot_color_ = new uint16_t[GC9A01A_PALETTE_SLOTS];
+                    this->palette_slot_index_ = new uint16_t[GC9A01A_PALETTE_SLOTS];
+                    this->reset_palette_();
+                }
+            }
+
+            // Staging strip for flushes and fills. In DMA-capable internal RAM (dma: true) the SPI driver sends
+            // it without bouncing through a temporary copy, which a PSRAM framebuffer would need.
+            this->strip_buffer_ = this->allocate_transport_buffer_(GC9A01A_STRIP_BYTES);
+            if (this->strip_buffer_ == nullptr)
+            {
+                ESP_LOGW(TAG, "No staging strip, streaming rows straight from the framebuffer");
+            }
 
             // Set ready state
             this->is_ready_ = true;
 
-            // Test with red fill
-            Color red_color = Color(255, 0, 0, 0); // Red, Green, Blue
-            this->fill(red_color);
+            // Clear the power-on RAM content of the panel
+            this->fill(Color::BLACK);
+            this->flush_();
         }
 
         void GC9A01ADisplay::update()
@@ -59,120 +191,80 @@ namespace esphome
                 return;
             }
 
-            static bool gpio_diagnostics_done = false;
-            static uint32_t test_delay_counter = 0;
-            static bool initial_dc_state = false;
-
-            if (!gpio_diagnostics_done)
+            // The panel is still receiving the previous frame: render again once it is done
+            if (this->frame_in_flight_)
             {
-                test_delay_counter++;
-
-                if (test_delay_counter == 20)
-                {
-
-                    ESP_LOGD(TAG, "Starting SPI transaction test");
-
-                    this->enable();
-
-                    // Test write operation
-                    uint8_t test_cmd = 0x9F; // Example: Read ID command
-                    this->write_byte(test_cmd);
-                    ESP_LOGD(TAG, "Sent command: 0x%02X", test_cmd);
-
-                    // Test read operation
-                    uint8_t buffer[3];
-                    this->read_array(buffer, sizeof(buffer));
-                    ESP_LOGD(TAG, "Read response: 0x%02X 0x%02X 0x%02X",
-                             buffer[0], buffer[1], buffer[2]);
-
-                    this->disable();
-                    ESP_LOGD(TAG, "SPI transaction test complete");
-                }
-                else if (test_delay_counter < 20)
-                {
-                    ESP_LOGI(TAG, "GPIO test countdown: %d updates until start", 20 - test_delay_counter);
-                }
+                this->update_pending_ = true;
+                if (this->stats_enabled_)
+                    this->stats_.stalls++;
+                return;
             }
 
-            // ESPHome DisplayBuffer Integration Control:
-            //
-            // The do_update_() call is the bridge between ESPHome's high-level drawing framework
-            // and our low-level hardware control methods. Here's how it works:
-            //
-            // WITH YAML lambda content (e.g., it.print(), it.line(), etc.):
-            //   1. ESPHome draws to internal DisplayBuffer pixel array
-            //   2. do_update_() compares current buffer with previous frame
-            //   3. For each changed pixel, calls draw_absolute_pixel_internal(x, y, color)
-            //   4. Our implementation converts pixels to GC9A01A hardware commands
-            //   5. Result: YAML drawing commands appear on physical display
-            //
-            // WITHOUT YAML lambda content (current state):
-            //   1. DisplayBuffer remains empty (no drawing commands executed)
-            //   2. do_update_() finds zero changed pixels
-            //   3. draw_absolute_pixel_internal() is never called
-            //   4. No visual effect - call is redundant
-            //
-            // CURRENT TROUBLESHOOTING STRATEGY:
-            //   - Focus on direct C++ hardware methods (fill(), write_color_(), etc.)
-            //   - Verify SPI communication and display controller before ESPHome integration
-            //   - All current visual output comes from setup() -> fill(red_color)
-            //   - Once hardware is proven working, re-enable for YAML lambda support
-            //
-            // Temporarily disabled while troubleshooting direct hardware methods
-            // this->do_update_();
-
-            // Diagnostic logging every 20 updates
-            this->update_counter_++;
-
-            if (this->update_counter_ % 20 == 0)
-            {
-                ESP_LOGI(TAG, "=== Diagnostic Report (Update #%d) ===", this->update_counter_);
-                ESP_LOGI(TAG, "Component Status:");
-                ESP_LOGI(TAG, "  Ready State: %s", this->is_ready_ ? "true" : "false");
-                ESP_LOGI(TAG, "  Display Dimensions: %dx%d", this->get_width_internal(), this->get_height_internal());
-                ESP_LOGI(TAG, "  Display Type: %d", (int)this->get_display_type());
-
-                // Add backlight pin diagnostics here:
-                ESP_LOGI(TAG, "Backlight Pin Status:");
-                if (this->backlight_pin_ != nullptr)
-                {
-                    bool backlight_state = this->backlight_pin_->digital_read();
+            // Render the YAML lambda / pages into the framebuffer, then push only the tiles that changed.
+            // In ASYNC mode the flush is started here and continued by loop().
+            this->do_update_();
+            if (this->transport_mode_ == TRANSPORT_ASYNC)
+            {
+                if (this->buffer_ != nullptr)
+                    this->start_async_frame_();
+            }
+            else
+            {
+                this->flush_();
+            }
+        }
 
-                    ESP_LOGI(TAG, "  Pin Configured: YES");
-                    ESP_LOGI(TAG, "  Pin Info: %s", this->backlight_pin_->dump_summary().c_str());
-                    ESP_LOGI(TAG, "  Current State: %s", backlight_state ? "HIGH" : "LOW");
+        void GC9A01ADisplay::loop()
+        {
+            if (!this->frame_in_flight_)
+                return;
 
-                    // Test if it's an internal pin for more details
-                    if (this->backlight_pin_->is_internal())
+            // Stream strips until the time budget is used up, then hand the main loop back
+            const uint32_t start = micros();
+            while (micros() - start < GC9A01A_FLUSH_BUDGET_US)
+            {
+                if (!this->flush_rect_active_)
+                {
+                    if (!this->next_flush_rect_(this->flush_rect_))
                     {
-                        InternalGPIOPin *internal_pin = static_cast<InternalGPIOPin *>(this->backlight_pin_);
-                        ESP_LOGI(TAG, "  Pin Number: %d", internal_pin->get_pin());
-                        ESP_LOGI(TAG, "  Is Inverted: %s", internal_pin->is_inverted() ? "YES" : "NO");
+                        this->finish_frame_();
+                        return;
                     }
+                    this->flush_rect_active_ = true;
+                    this->flush_row_ = this->flush_rect_.y1;
+                }
 
-                    // Test writing again to confirm:
-                    ESP_LOGI(TAG, "  Testing: Setting pin HIGH again...");
-                    this->backlight_pin_->digital_write(true);
-                    delay(10); // Small delay
-                    bool new_state = this->backlight_pin_->digital_read();
-                    ESP_LOGI(TAG, "  After write(true): %s", new_state ? "HIGH" : "LOW");
+                const uint16_t strip_rows =
+                    GC9A01A_STRIP_BYTES / ((this->flush_rect_.x2 - this->flush_rect_.x1 + 1) * this->panel_bytes_());
+                const uint16_t last_row = std::min<uint16_t>(this->flush_row_ + strip_rows - 1, this->flush_rect_.y2);
+                this->send_rows_(this->flush_rect_, this->flush_row_, last_row);
 
-                    if (backlight_state)
-                    {
-                        ESP_LOGI(TAG, "  Status: CORRECT - Backlight should be illuminated");
-                    }
-                    else
-                    {
-                        ESP_LOGW(TAG, "  Status: PROBLEM - Backlight pin is LOW, display may be dark");
-                    }
-                }
-                else
-                {
-                    ESP_LOGW(TAG, "  Pin Configured: NO - backlight_pin_ is nullptr");
-                    ESP_LOGW(TAG, "  Status: PROBLEM - No backlight control available");
-                }
+                this->flush_row_ = last_row + 1;
+                if (this->flush_row_ > this->flush_rect_.y2)
+                    this->flush_rect_active_ = false;
+            }
+        }
+
+        void GC9A01ADisplay::start_async_frame_()
+        {
+            if (this->frame_in_flight_)
+                return;
+            this->palette_compact_tried_ = false;
+            this->skip_unchanged_tiles_();
+            this->frame_in_flight_ = true;
+            this->frame_start_us_ = micros();
+            this->frame_start_pixels_ = this->stats_.pixels;
+        }
 
-                ESP_LOGI(TAG, "=== End Diagnostic Report ===");
+        void GC9A01ADisplay::finish_frame_()
+        {
+            if (this->stats_.pixels != this->frame_start_pixels_)
+                this->record_frame_(micros() - this->frame_start_us_);
+            this->frame_in_flight_ = false;
+            if (this->update_pending_)
+            {
+                this->update_pending_ = false;
+                this->update();
             }
         }
 
@@ -182,6 +274,23 @@ namespace esphome
             LOG_PIN("  DC Pin: ", this->dc_pin_);
             LOG_PIN("  Reset Pin: ", this->reset_pin_);
             LOG_PIN("  Backlight Pin: ", this->backlight_pin_);
+            ESP_LOGCONFIG(TAG, "  Transport: %s", this->transport_mode_ == TRANSPORT_ASYNC ? "ASYNC" : "BLOCKING");
+            ESP_LOGCONFIG(TAG, "  Display ID: 0x%06X", (unsigned) this->display_id_);
+            ESP_LOGCONFIG(TAG, "  SPI Data Rate: %u Hz%s", (unsigned) this->data_rate_,
+                          this->data_rate_tuned_ ? " (calibrated)" : "");
+            ESP_LOGCONFIG(TAG, "  Pixel Mode: %s", this->pixel_mode_ == PIXEL_MODE_RGB666 ? "RGB666" : "RGB565");
+            if (this->buffer_ == nullptr)
+            {
+                ESP_LOGCONFIG(TAG, "  Framebuffer: NO");
+            }
+            else
+            {
+                ESP_LOGCONFIG(TAG, "  Framebuffer: %s (%u bytes)",
+                              this->buffer_format_ == BUFFER_FORMAT_INDEXED8 ? "INDEXED8" : "RGB565",
+                              (unsigned) (GC9A01A_WIDTH * GC9A01A_HEIGHT * this->buffer_bytes_()));
+            }
+            ESP_LOGCONFIG(TAG, "  Skip Unchanged Tiles: %s", YESNO(this->skip_unchanged_));
+            ESP_LOGCONFIG(TAG, "  DMA Staging: %s", YESNO(this->strip_buffer_ != nullptr && this->get_transport_dma()));
             ESP_LOGCONFIG(TAG, "  Width: %d, Height: %d", this->get_width_internal(), this->get_height_internal());
         }
 
@@ -192,36 +301,68 @@ namespace esphome
 
         void GC9A01ADisplay::fill(Color color)
         {
-            ESP_LOGI(TAG, "Fill called with color R:%d G:%d B:%d, ready: %s",
-                     color.red, color.green, color.blue, this->is_ready_ ? "true" : "false");
-
             if (!this->is_ready_)
                 return;
 
             uint16_t color565 = this->color_to_565_(color);
-            ESP_LOGI(TAG, "Converted to RGB565: 0x%04X", color565);
 
-            // Debug: Log what we're about to do
-            ESP_LOGI(TAG, "Setting address window to full screen: 0,0 to %d,%d",
-                     GC9A01A_WIDTH - 1, GC9A01A_HEIGHT - 1);
+            if (this->buffer_ == nullptr)
+            {
+                // No framebuffer: stream the fill straight to the panel, skipping the invisible corners
+                for (uint16_t band = 0, band_end; band < GC9A01A_HEIGHT; band = band_end + 1)
+                {
+                    band_end = this->band_end_(band, GC9A01A_HEIGHT - 1);
+                    uint16_t x1 = 0;
+                    uint16_t x2 = GC9A01A_WIDTH - 1;
+                    this->clip_to_round_(x1, x2, band, band_end);
+                    this->set_addr_window_(x1, band, x2, band_end);
+                    this->write_color_(color565, (x2 - x1 + 1) * (band_end - band + 1));
+                }
+                return;
+            }
 
-            this->set_addr_window_(0, 0, GC9A01A_WIDTH - 1, GC9A01A_HEIGHT - 1);
+            if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+            {
+                // Every pixel is overwritten, so the palette starts over with the fill color
+                this->reset_palette_();
+                memset(this->buffer_, this->palette_index_(color565), GC9A01A_WIDTH * GC9A01A_HEIGHT);
+                this->mark_all_dirty_();
+                return;
+            }
 
-            ESP_LOGI(TAG, "Writing %d pixels of color 0x%04X",
-                     GC9A01A_WIDTH * GC9A01A_HEIGHT, color565);
+            uint8_t color_high = color565 >> 8;
+            uint8_t color_low = color565 & 0xFF;
+            const uint32_t length = GC9A01A_WIDTH * GC9A01A_HEIGHT * 2;
 
-            this->write_color_(color565, GC9A01A_WIDTH * GC9A01A_HEIGHT);
+            if (color_high == color_low)
+            {
+                memset(this->buffer_, color_high, length);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < length; i += 2)
+                {
+                    this->buffer_[i] = color_high;
+                    this->buffer_[i + 1] = color_low;
+                }
+            }
 
-            ESP_LOGI(TAG, "Fill operation complete");
+            this->mark_all_dirty_();
         }
 
-        void GC9A01ADisplay::draw_absolute_pixel_internal(int x, int y, Color color)
+        void HOT GC9A01ADisplay::draw_absolute_pixel_internal(int x, int y, Color color)
         {
             if (x < 0 || x >= this->get_width_internal() || y < 0 || y >= this->get_height_internal())
             {
                 return;
             }
 
+            // Outside the round glass (rows in the scroll area can move into view)
+            if ((x < GC9A01A_ROUND_MASK.start[y] || x > GC9A01A_ROUND_MASK.end[y]) && !this->in_scroll_area_(y))
+            {
+                return;
+            }
+
             if (!this->is_ready_)
             {
                 ESP_LOGW(TAG, "Display not ready for pixel draw");
@@ -229,8 +370,160 @@ namespace esphome
             }
 
             uint16_t color565 = this->color_to_565_(color);
-            this->set_addr_window_(x, y, x, y);
-            this->write_data_16_(color565);
+
+            if (this->buffer_ == nullptr)
+            {
+                // No framebuffer: one address window per pixel
+                this->set_addr_window_(x, y, x, y);
+                this->write_pixel_(color565);
+                return;
+            }
+
+            uint32_t pos = y * GC9A01A_WIDTH + x;
+            if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+            {
+                this->buffer_[pos] = this->palette_index_(color565);
+            }
+            else
+            {
+                this->buffer_[pos * 2] = color565 >> 8;
+                this->buffer_[pos * 2 + 1] = color565 & 0xFF;
+            }
+            this->mark_dirty_(x, y);
+        }
+
+        void GC9A01ADisplay::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr,
+                                            display::ColorOrder order, display::ColorBitness bitness, bool big_endian,
+                                            int x_offset, int y_offset, int x_pad)
+        {
+            if (!this->is_ready_ || w <= 0 || h <= 0)
+                return;
+
+            // Only unrotated RGB565 can be copied as-is; anything else takes the generic per-pixel path.
+            // Little-endian RGB565 is byte-swapped while copying and RGB666 is expanded, so without a framebuffer
+            // both need the staging strip.
+            if (bitness != display::COLOR_BITNESS_565 || order != display::COLOR_ORDER_RGB ||
+                this->rotation_ != display::DISPLAY_ROTATION_0_DEGREES ||
+                (this->buffer_ == nullptr && this->strip_buffer_ == nullptr &&
+                 (!big_endian || this->pixel_mode_ == PIXEL_MODE_RGB666)))
+            {
+                display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset,
+                                                 y_offset, x_pad);
+                return;
+            }
+
+            // Source row stride, fixed before clipping changes w and x_offset
+            const size_t src_stride = (x_offset + w + x_pad) * 2;
+
+            // Clip the rectangle to the panel, shifting the source origin along with it
+            if (x_start < 0)
+            {
+                x_offset -= x_start;
+                w += x_start;
+                x_start = 0;
+            }
+            if (y_start < 0)
+            {
+                y_offset -= y_start;
+                h += y_start;
+                y_start = 0;
+            }
+            w = std::min(w, GC9A01A_WIDTH - x_start);
+            h = std::min(h, GC9A01A_HEIGHT - y_start);
+            if (w <= 0 || h <= 0)
+                return;
+
+            const uint8_t *src = ptr + y_offset * src_stride + x_offset * 2;
+
+            auto copy_row = [big_endian](uint8_t *dst, const uint8_t *row, size_t bytes)
+            {
+                if (big_endian)
+                {
+                    memcpy(dst, row, bytes);
+                    return;
+                }
+                for (size_t i = 0; i < bytes; i += 2)
+                {
+                    dst[i] = row[i + 1];
+                    dst[i + 1] = row[i];
+                }
+            };
+            auto load_pixel = [big_endian](const uint8_t *row, int i) -> uint16_t
+            {
+                return big_endian ? (row[i * 2] << 8) | row[i * 2 + 1] : (row[i * 2 + 1] << 8) | row[i * 2];
+            };
+
+            if (this->buffer_ != nullptr)
+            {
+                // Only the visible chord of every row is copied, whole rows inside the scroll area
+                for (int y = 0; y < h; y++)
+                {
+                    const int row = y_start + y;
+                    const bool whole = this->in_scroll_area_(row);
+                    const int x1 = whole ? x_start : std::max<int>(x_start, GC9A01A_ROUND_MASK.start[row]);
+                    const int x2 = whole ? x_start + w - 1 : std::min<int>(x_start + w - 1, GC9A01A_ROUND_MASK.end[row]);
+                    if (x1 > x2)
+                        continue;
+                    const uint8_t *src_row = src + y * src_stride + (x1 - x_start) * 2;
+                    if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+                    {
+                        uint8_t *dst = this->buffer_ + row * GC9A01A_WIDTH + x1;
+                        for (int i = 0; i <= x2 - x1; i++)
+                            dst[i] = this->palette_index_(load_pixel(src_row, i));
+                    }
+                    else
+                    {
+                        copy_row(this->buffer_ + (row * GC9A01A_WIDTH + x1) * 2, src_row, (x2 - x1 + 1) * 2);
+                    }
+                }
+
+                this->mark_dirty_rect_(x_start, y_start, x_start + w - 1, y_start + h - 1);
+                this->commit_dirty_();
+                return;
+            }
+
+            // No framebuffer: the rectangle is sent band by band, each band clipped to the round glass
+            // and streamed with one address window and one RAMWR burst. Each call counts as one flush.
+            const uint32_t start = micros();
+            for (int band = 0, band_rows; band < h; band += band_rows)
+            {
+                band_rows = this->band_end_(y_start + band, y_start + h - 1) - (y_start + band) + 1;
+                uint16_t x1 = x_start;
+                uint16_t x2 = x_start + w - 1;
+                if (!this->clip_to_round_(x1, x2, y_start + band, y_start + band + band_rows - 1))
+                    continue;
+
+                const uint16_t row_pixels = x2 - x1 + 1;
+                const size_t row_bytes = row_pixels * 2;
+                const uint8_t *band_src = src + band * src_stride + (x1 - x_start) * 2;
+
+                this->set_addr_window_(x1, y_start + band, x2, y_start + band + band_rows - 1);
+                this->begin_stream_();
+                if (this->strip_buffer_ == nullptr)
+                {
+                    for (int y = 0; y < band_rows; y++)
+                        this->stream_(band_src + y * src_stride, row_bytes);
+                }
+                else if (this->pixel_mode_ == PIXEL_MODE_RGB666)
+                {
+                    uint8_t *out = this->strip_buffer_;
+                    for (int y = 0; y < band_rows; y++)
+                    {
+                        for (uint16_t i = 0; i < row_pixels; i++)
+                            out += this->encode_565_(out, load_pixel(band_src + y * src_stride, i));
+                    }
+                    this->stream_(this->strip_buffer_, out - this->strip_buffer_);
+                }
+                else
+                {
+                    for (int y = 0; y < band_rows; y++)
+                        copy_row(this->strip_buffer_ + y * row_bytes, band_src + y * src_stride, row_bytes);
+                    this->stream_(this->strip_buffer_, band_rows * row_bytes);
+                }
+                this->end_stream_();
+                this->count_pixels_(row_pixels * band_rows);
+            }
+            this->record_frame_(micros() - start);
         }
 
         int GC9A01ADisplay::get_height_internal() { return GC9A01A_HEIGHT; }
@@ -243,345 +536,776 @@ namespace esphome
         {
             ESP_LOGD(TAG, "Initializing GC9A01A display...");
 
-            // Software reset
-            this->write_command_(GC9A01A_SWRESET);
-            delay(120);
+            // Each entry is sent as one CS-asserted command+parameters transaction
+            for (const uint8_t *entry = GC9A01A_INIT_SEQUENCE; *entry != GC9A01A_INIT_END;)
+            {
+                const uint8_t cmd = entry[0];
+                const uint8_t num_args = entry[1];
+                this->send_command_(cmd, entry + 2, num_args);
 
-            // Sleep out
-            this->write_command_(GC9A01A_SLPOUT);
-            delay(120);
+                const uint8_t delay_ms = entry[2 + num_args];
+                if (delay_ms != 0)
+                    delay(delay_ms);
 
-            // Pixel format: 16 bits per pixel (RGB565)
-            this->write_command_(GC9A01A_COLMOD);
-            this->write_data_(0x55);
+                entry += 3 + num_args;
+            }
 
-            // Memory access control (rotation and color order)
-            this->write_command_(GC9A01A_MADCTL);
-            uint8_t madctl = GC9A01A_MADCTL_BGR; // Set BGR color order
-            this->write_data_(madctl);
+            // Interface pixel format: 16 bits (RGB565) or 18 bits (RGB666) per pixel
+            const uint8_t colmod = this->pixel_mode_ == PIXEL_MODE_RGB666 ? 0x66 : 0x55;
+            this->send_command_(GC9A01A_COLMOD, &colmod, 1);
 
-            // GC9A01A specific initialization sequence
-            this->write_command_(0xEF);
+            ESP_LOGD(TAG, "GC9A01A display initialization complete");
+        }
 
-            this->write_command_(0xEB);
-            this->write_data_(0x14);
+        void GC9A01ADisplay::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+        {
+            // CASET, RASET and RAMWR as three transactions, each command sent together with its parameters.
+            // Rows are display rows; with a scroll offset they are moved to the RAM rows shown there
+            // (callers split bands with band_end_(), so y1..y2 stays one consecutive run of RAM rows).
+            y2 = this->ram_row_(y1) + (y2 - y1);
+            y1 = this->ram_row_(y1);
+            const uint8_t columns[4] = {uint8_t(x1 >> 8), uint8_t(x1 & 0xFF), uint8_t(x2 >> 8), uint8_t(x2 & 0xFF)};
+            const uint8_t rows[4] = {uint8_t(y1 >> 8), uint8_t(y1 & 0xFF), uint8_t(y2 >> 8), uint8_t(y2 & 0xFF)};
+
+            this->send_command_(GC9A01A_CASET, columns, sizeof(columns)); // Column address set
+            this->send_command_(GC9A01A_RASET, rows, sizeof(rows));       // Row address set
+            this->send_command_(GC9A01A_RAMWR, nullptr, 0);               // Write to RAM
+        }
 
-            this->write_command_(0xFE);
-            this->write_command_(0xEF);
+        void GC9A01ADisplay::write_pixel_(uint16_t color)
+        {
+            uint8_t data[3];
+            const size_t length = this->encode_565_(data, color); // RGB565 or RGB666 bytes, MSB first
+            this->begin_stream_();                                 // DC high, CS asserted
+            this->stream_(data, length);                           // Send the whole pixel
+            this->end_stream_();                                   // Deassert CS to end transaction
+            this->count_pixels_(1);
+        }
 
-            this->write_command_(0xEB);
-            this->write_data_(0x14);
+        void GC9A01ADisplay::write_color_(uint16_t color, uint32_t count)
+        {
+            // Fills a region of the display with the same color by writing multiple identical pixels.
+            // The pixels are repeated into a chunk buffer and sent with stream_() instead of byte by byte.
+            uint8_t chunk[96];
+            uint8_t *out = this->strip_buffer_ != nullptr ? this->strip_buffer_ : chunk;
+            const uint8_t pixel_bytes = this->panel_bytes_();
+            const uint32_t out_pixels = (this->strip_buffer_ != nullptr ? GC9A01A_STRIP_BYTES : sizeof(chunk)) / pixel_bytes;
+            const uint32_t fill_pixels = std::min(count, out_pixels);
 
-            this->write_command_(0x84);
-            this->write_data_(0x40);
+            for (uint32_t i = 0; i < fill_pixels; i++)
+                this->encode_565_(out + i * pixel_bytes, color);
 
-            this->write_command_(0x85);
-            this->write_data_(0xFF);
+            this->begin_stream_(); // Data mode, pixel data follows
 
-            this->write_command_(0x86);
-            this->write_data_(0xFF);
+            this->count_pixels_(count);
+            while (count > 0)
+            {
+                uint32_t pixels = std::min(count, fill_pixels);
+                this->stream_(out, pixels * pixel_bytes);
+                count -= pixels;
+            }
 
-            this->write_command_(0x87);
-            this->write_data_(0xFF);
+            this->end_stream_(); // End SPI transaction
+        }
 
-            this->write_command_(0x88);
-            this->write_data_(0x0A);
+        bool GC9A01ADisplay::clip_to_round_(uint16_t &x1, uint16_t &x2, uint16_t y1, uint16_t y2)
+        {
+            // Narrows x1..x2 to the widest visible chord of rows y1..y2; false if nothing is visible.
+            // Callers keep bands short, so the rectangle stays one address window with little waste.
+            // Bands never cross the scroll area boundary, and rows inside it are sent whole.
+            if (this->in_scroll_area_(y1))
+                return true;
+            uint8_t start = GC9A01A_ROUND_MASK.start[y1];
+            uint8_t end = GC9A01A_ROUND_MASK.end[y1];
+            for (uint16_t y = y1 + 1; y <= y2; y++)
+            {
+                start = std::min(start, GC9A01A_ROUND_MASK.start[y]);
+                end = std::max(end, GC9A01A_ROUND_MASK.end[y]);
+            }
+            x1 = std::max<uint16_t>(x1, start);
+            x2 = std::min<uint16_t>(x2, end);
+            return x1 <= x2;
+        }
 
-            this->write_command_(0x89);
-            this->write_data_(0x21);
+        uint16_t GC9A01ADisplay::band_end_(uint16_t band, uint16_t y2)
+        {
+            // Last row of the band starting at display row band: at most GC9A01A_CLIP_BAND_ROWS rows, and
+            // cut at the scroll area edges and at the row where the scrolled RAM rows wrap around,
+            // so that one address window covers the whole band.
+            uint16_t end = std::min<uint16_t>(band + GC9A01A_CLIP_BAND_ROWS - 1, y2);
+            if (this->scroll_rows_ == 0)
+                return end;
+            const uint16_t area_end = this->scroll_top_ + this->scroll_rows_ - 1;
+            if (band < this->scroll_top_)
+                return std::min<uint16_t>(end, this->scroll_top_ - 1);
+            if (band > area_end)
+                return end;
+            const uint16_t wrap = area_end - this->scroll_offset_; // Shows the last RAM row of the area
+            return std::min<uint16_t>(end, band <= wrap ? wrap : area_end);
+        }
 
-            this->write_command_(0x8A);
-            this->write_data_(0x00);
+        uint16_t GC9A01ADisplay::ram_row_(uint16_t y) const
+        {
+            // Panel RAM row shown at display row y
+            if (!this->in_scroll_area_(y))
+                return y;
+            return this->scroll_top_ + (y - this->scroll_top_ + this->scroll_offset_) % this->scroll_rows_;
+        }
 
-            this->write_command_(0x8B);
-            this->write_data_(0x80);
+        void GC9A01ADisplay::drain_()
+        {
+            // Sends what the ASYNC transport has not pushed yet, so panel RAM matches the framebuffer.
+            // An in-flight frame is still finished by loop(), which then finds nothing left to send.
+            if (this->buffer_ == nullptr)
+                return;
+            if (this->flush_rect_active_)
+            {
+                this->send_rows_(this->flush_rect_, this->flush_row_, this->flush_rect_.y2);
+                this->flush_rect_active_ = false;
+            }
+            this->flush_();
+        }
 
-            this->write_command_(0x8C);
-            this->write_data_(0x01);
+        void GC9A01ADisplay::set_scroll_area(uint16_t top_fixed, uint16_t bottom_fixed)
+        {
+            if (top_fixed + bottom_fixed >= GC9A01A_HEIGHT)
+            {
+                ESP_LOGW(TAG, "Invalid scroll area: %u fixed rows at the top, %u at the bottom", top_fixed, bottom_fixed);
+                return;
+            }
+
+            this->drain_();
+            const uint16_t rows = GC9A01A_HEIGHT - top_fixed - bottom_fixed;
+            const uint8_t definition[6] = {uint8_t(top_fixed >> 8), uint8_t(top_fixed & 0xFF), uint8_t(rows >> 8),
+                                           uint8_t(rows & 0xFF), uint8_t(bottom_fixed >> 8), uint8_t(bottom_fixed & 0xFF)};
+            const uint8_t start[2] = {uint8_t(top_fixed >> 8), uint8_t(top_fixed & 0xFF)};
+            this->send_command_(GC9A01A_VSCRDEF, definition, sizeof(definition));
+            this->send_command_(GC9A01A_VSCRSADD, start, sizeof(start));
+
+            this->scroll_top_ = top_fixed;
+            this->scroll_rows_ = rows;
+            this->scroll_offset_ = 0;
+            this->forget_tiles_();
+
+            // The corners of the scroll area were clipped so far; send it whole once
+            this->mark_all_dirty_();
+        }
+
+        void GC9A01ADisplay::scroll_by(int16_t rows)
+        {
+            if (this->scroll_rows_ == 0)
+            {
+                ESP_LOGW(TAG, "scroll_by() needs set_scroll_area() first");
+                return;
+            }
+
+            const uint16_t shift = ((rows % this->scroll_rows_) + this->scroll_rows_) % this->scroll_rows_;
+            if (shift == 0)
+                return;
 
-            this->write_command_(0x8D);
-            this->write_data_(0x01);
+            // Pending pixels are sent with the old offset first
+            this->drain_();
 
-            this->write_command_(0x8E);
-            this->write_data_(0xFF);
+            // Keep the framebuffer equal to what the panel shows: rotate the rows of the scroll area
+            if (this->buffer_ != nullptr)
+            {
+                const size_t row_bytes = GC9A01A_WIDTH * this->buffer_bytes_();
+                uint8_t *first = this->buffer_ + this->scroll_top_ * row_bytes;
+                std::rotate(first, first + shift * row_bytes, first + this->scroll_rows_ * row_bytes);
+            }
 
-            this->write_command_(0x8F);
-            this->write_data_(0xFF);
+            this->scroll_offset_ = (this->scroll_offset_ + shift) % this->scroll_rows_;
+            this->forget_tiles_();
+            const uint16_t start = this->scroll_top_ + this->scroll_offset_;
+            const uint8_t data[2] = {uint8_t(start >> 8), uint8_t(start & 0xFF)};
+            this->send_command_(GC9A01A_VSCRSADD, data, sizeof(data));
+        }
 
-            this->write_command_(0xB6);
-            this->write_data_(0x00);
-            this->write_data_(0x20);
+        void GC9A01ADisplay::reset_scroll()
+        {
+            if (this->scroll_rows_ == 0)
+                return;
 
-            this->write_command_(0x36);
-            this->write_data_(madctl);
+            this->drain_();
+            const uint8_t definition[6] = {0, 0, uint8_t(GC9A01A_HEIGHT >> 8), uint8_t(GC9A01A_HEIGHT & 0xFF), 0, 0};
+            const uint8_t start[2] = {0, 0};
+            this->send_command_(GC9A01A_VSCRDEF, definition, sizeof(definition));
+            this->send_command_(GC9A01A_VSCRSADD, start, sizeof(start));
 
-            this->write_command_(0x3A);
-            this->write_data_(0x05);
-
-            this->write_command_(0x90);
-            this->write_data_(0x08);
-            this->write_data_(0x08);
-            this->write_data_(0x08);
-            this->write_data_(0x08);
-
-            this->write_command_(0xBD);
-            this->write_data_(0x06);
-
-            this->write_command_(0xBC);
-            this->write_data_(0x00);
-
-            this->write_command_(0xFF);
-            this->write_data_(0x60);
-            this->write_data_(0x01);
-            this->write_data_(0x04);
-
-            this->write_command_(0xC3);
-            this->write_data_(0x13);
-
-            this->write_command_(0xC4);
-            this->write_data_(0x13);
-
-            this->write_command_(0xC9);
-            this->write_data_(0x22);
-
-            this->write_command_(0xBE);
-            this->write_data_(0x11);
-
-            this->write_command_(0xE1);
-            this->write_data_(0x10);
-            this->write_data_(0x0E);
-
-            this->write_command_(0xDF);
-            this->write_data_(0x21);
-            this->write_data_(0x0C);
-            this->write_data_(0x02);
-
-            this->write_command_(0xF0);
-            this->write_data_(0x45);
-            this->write_data_(0x09);
-            this->write_data_(0x08);
-            this->write_data_(0x08);
-            this->write_data_(0x26);
-            this->write_data_(0x2A);
-
-            this->write_command_(0xF1);
-            this->write_data_(0x43);
-            this->write_data_(0x70);
-            this->write_data_(0x72);
-            this->write_data_(0x36);
-            this->write_data_(0x37);
-            this->write_data_(0x6F);
-
-            this->write_command_(0xF2);
-            this->write_data_(0x45);
-            this->write_data_(0x09);
-            this->write_data_(0x08);
-            this->write_data_(0x08);
-            this->write_data_(0x26);
-            this->write_data_(0x2A);
-
-            this->write_command_(0xF3);
-            this->write_data_(0x43);
-            this->write_data_(0x70);
-            this->write_data_(0x72);
-            this->write_data_(0x36);
-            this->write_data_(0x37);
-            this->write_data_(0x6F);
-
-            this->write_command_(0xED);
-            this->write_data_(0x1B);
-            this->write_data_(0x0B);
-
-            this->write_command_(0xAE);
-            this->write_data_(0x77);
-
-            this->write_command_(0xCD);
-            this->write_data_(0x63);
-
-            this->write_command_(0x70);
-            this->write_data_(0x07);
-            this->write_data_(0x07);
-            this->write_data_(0x04);
-            this->write_data_(0x0E);
-            this->write_data_(0x0F);
-            this->write_data_(0x09);
-            this->write_data_(0x07);
-            this->write_data_(0x08);
-            this->write_data_(0x03);
-
-            this->write_command_(0xE8);
-            this->write_data_(0x34);
-
-            this->write_command_(0x62);
-            this->write_data_(0x18);
-            this->write_data_(0x0D);
-            this->write_data_(0x71);
-            this->write_data_(0xED);
-            this->write_data_(0x70);
-            this->write_data_(0x70);
-            this->write_data_(0x18);
-            this->write_data_(0x0F);
-            this->write_data_(0x71);
-            this->write_data_(0xEF);
-            this->write_data_(0x70);
-            this->write_data_(0x70);
-
-            this->write_command_(0x63);
-            this->write_data_(0x18);
-            this->write_data_(0x11);
-            this->write_data_(0x71);
-            this->write_data_(0xF1);
-            this->write_data_(0x70);
-            this->write_data_(0x70);
-            this->write_data_(0x18);
-            this->write_data_(0x13);
-            this->write_data_(0x71);
-            this->write_data_(0xF3);
-            this->write_data_(0x70);
-            this->write_data_(0x70);
-
-            this->write_command_(0x64);
-            this->write_data_(0x28);
-            this->write_data_(0x29);
-            this->write_data_(0xF1);
-            this->write_data_(0x01);
-            this->write_data_(0xF1);
-            this->write_data_(0x00);
-            this->write_data_(0x07);
-
-            this->write_command_(0x66);
-            this->write_data_(0x3C);
-            this->write_data_(0x00);
-            this->write_data_(0xCD);
-            this->write_data_(0x67);
-            this->write_data_(0x45);
-            this->write_data_(0x45);
-            this->write_data_(0x10);
-            this->write_data_(0x00);
-            this->write_data_(0x00);
-            this->write_data_(0x00);
-
-            this->write_command_(0x67);
-            this->write_data_(0x00);
-            this->write_data_(0x3C);
-            this->write_data_(0x00);
-            this->write_data_(0x00);
-            this->write_data_(0x00);
-            this->write_data_(0x01);
-            this->write_data_(0x54);
-            this->write_data_(0x10);
-            this->write_data_(0x32);
-            this->write_data_(0x98);
-
-            this->write_command_(0x74);
-            this->write_data_(0x10);
-            this->write_data_(0x85);
-            this->write_data_(0x80);
-            this->write_data_(0x00);
-            this->write_data_(0x00);
-            this->write_data_(0x4E);
-            this->write_data_(0x00);
-
-            this->write_command_(0x98);
-            this->write_data_(0x3E);
-            this->write_data_(0x07);
-
-            this->write_command_(GC9A01A_INVON); // Display inversion on
-            delay(10);
-
-            this->write_command_(GC9A01A_NORON); // Normal display mode on
-            delay(10);
-
-            this->write_command_(GC9A01A_DISPON); // Display on
-            delay(120);
+            this->scroll_top_ = 0;
+            this->scroll_rows_ = 0;
+            this->scroll_offset_ = 0;
+            this->forget_tiles_();
 
-            ESP_LOGD(TAG, "GC9A01A display initialization complete");
+            // RAM rows are back in display order: resend everything
+            this->mark_all_dirty_();
         }
 
-        void GC9A01ADisplay::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+        void GC9A01ADisplay::set_partial_area(uint16_t y1, uint16_t y2)
         {
-            this->write_command_(GC9A01A_CASET); // Column address set
-            this->write_data_16_(x1);
-            this->write_data_16_(x2);
+            if (y1 > y2 || y2 >= GC9A01A_HEIGHT)
+            {
+                ESP_LOGW(TAG, "Invalid partial area: rows %u-%u", y1, y2);
+                return;
+            }
 
-            this->write_command_(GC9A01A_RASET); // Row address set
-            this->write_data_16_(y1);
-            this->write_data_16_(y2);
+            const uint8_t rows[4] = {uint8_t(y1 >> 8), uint8_t(y1 & 0xFF), uint8_t(y2 >> 8), uint8_t(y2 & 0xFF)};
+            this->send_command_(GC9A01A_PTLAR, rows, sizeof(rows));
+            this->send_command_(GC9A01A_PTLON, nullptr, 0);
 
-            this->write_command_(GC9A01A_RAMWR); // Write to RAM
+            this->partial_active_ = true;
+            this->partial_y1_ = y1;
+            this->partial_y2_ = y2;
         }
 
-        void GC9A01ADisplay::write_command_(uint8_t cmd)
+        void GC9A01ADisplay::clear_partial_area()
         {
-            ESP_LOGV(TAG, "Writing command: 0x%02X", cmd);
+            if (!this->partial_active_)
+                return;
+
+            this->send_command_(GC9A01A_NORON, nullptr, 0);
+            this->partial_active_ = false;
+            this->forget_tiles_();
 
-            // Standard SPI display protocol sequence verified in ESPHome codebase:
-            // 1. All ESPHome display components (ST7789, ILI9XXX, etc.) use this exact pattern
-            // 2. DC pin must be stable BEFORE CS assertion per SPI display timing requirements
-            // 3. ESP32 gpio_set_level() provides immediate hardware pin control for proper setup/hold times
-            // 4. Each transaction is atomic: DC->CS->DATA->CS ensures clean command/data separation
-            // Pattern aligned with how SPI is sequenced and timed in working Arduino code:
-            this->dc_pin_->digital_write(false); // 1. DC pin FIRST (command mode)
-            this->enable_();                     // 2. CS pin SECOND (select device)
-            this->write_byte(cmd);               // 3. Send command
-            this->disable_();                    // 4. CS pin release (deselect device)
+            // Rows outside the partial area were skipped while it was active
+            this->mark_all_dirty_();
         }
 
-        void GC9A01ADisplay::write_data_(uint8_t data)
+        void GC9A01ADisplay::mark_dirty_(int x, int y)
         {
-            ESP_LOGV(TAG, "Writing data: 0x%02X", data);
+            this->dirty_tiles_[y / GC9A01A_TILE_SIZE] |= 1 << (x / GC9A01A_TILE_SIZE);
+            // Tile hashes are taken when a frame starts: a tile drawn while a frame is in flight may go out
+            // with other content than its hash says, so it must not be skipped by the next frame either
+            if (this->frame_in_flight_)
+                this->tile_hashes_[(y / GC9A01A_TILE_SIZE) * GC9A01A_TILE_COLS + x / GC9A01A_TILE_SIZE] = 0;
+        }
 
-            // Standard SPI display protocol sequence verified in ESPHome codebase:
-            // 1. All ESPHome display components (ST7789, ILI9XXX, etc.) use this exact pattern
-            // 2. DC pin must be stable BEFORE CS assertion per SPI display timing requirements
-            // 3. ESP32 gpio_set_level() provides immediate hardware pin control for proper setup/hold times
-            // 4. Each transaction is atomic: DC->CS->DATA->CS ensures clean command/data separation
-            // Pattern aligned with how SPI is sequenced and timed in working Arduino code:
-            this->dc_pin_->digital_write(true); // 1. DC pin FIRST (data mode)
-            this->enable_();                    // 2. CS pin SECOND (select device)
-            this->write_byte(data);             // 3. Send data
-            this->disable_();                   // 4. CS pin release (deselect device)
+        void GC9A01ADisplay::mark_all_dirty_()
+        {
+            // Tiles entirely outside the round glass are never sent, except inside the scroll area
+            for (uint16_t ty = 0; ty < GC9A01A_TILE_ROWS; ty++)
+                this->dirty_tiles_[ty] = GC9A01A_ROUND_MASK.tiles[ty];
+            for (uint16_t ty = this->scroll_top_ / GC9A01A_TILE_SIZE;
+                 this->scroll_rows_ != 0 && ty <= (this->scroll_top_ + this->scroll_rows_ - 1) / GC9A01A_TILE_SIZE; ty++)
+                this->dirty_tiles_[ty] = (1 << GC9A01A_TILE_COLS) - 1;
+            // See mark_dirty_()
+            if (this->frame_in_flight_)
+                this->forget_tiles_();
         }
 
-        void GC9A01ADisplay::write_data_16_(uint16_t data)
+        void GC9A01ADisplay::mark_dirty_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
         {
-            this->dc_pin_->digital_write(true); // Set DC HIGH for data mode (consistent with write_data_() pattern)
-            this->enable_();                    // Assert CS to start SPI transaction
-            this->write_byte(data >> 8);        // Send high byte (bits 15-8) first - big-endian MSB transmission
-            this->write_byte(data & 0xFF);      // Send low byte (bits 7-0) second - completes 16-bit value
-            this->disable_();                   // Deassert CS to end transaction
+            const uint16_t run = ((1 << (x2 / GC9A01A_TILE_SIZE + 1)) - 1) & ~((1 << (x1 / GC9A01A_TILE_SIZE)) - 1);
+            for (uint16_t ty = y1 / GC9A01A_TILE_SIZE; ty <= y2 / GC9A01A_TILE_SIZE; ty++)
+            {
+                this->dirty_tiles_[ty] |= run;
+                // See mark_dirty_()
+                if (this->frame_in_flight_)
+                {
+                    for (uint16_t tx = x1 / GC9A01A_TILE_SIZE; tx <= x2 / GC9A01A_TILE_SIZE; tx++)
+                        this->tile_hashes_[ty * GC9A01A_TILE_COLS + tx] = 0;
+                }
+            }
         }
 
-        void GC9A01ADisplay::write_color_(uint16_t color, uint32_t count)
+        void GC9A01ADisplay::commit_dirty_()
         {
-            // Fills a region of the display with the same color by writing multiple identical RGB565 pixels.
+            // Pushes dirty tiles outside of update(), e.g. after an LVGL flush with update_interval: never
+            if (this->transport_mode_ == TRANSPORT_ASYNC)
+            {
+                this->start_async_frame_();
+            }
+            else
+            {
+                this->flush_();
+            }
+        }
 
-            this->dc_pin_->digital_write(true); // Set data mode (pixel data follows)
-            this->enable_();                    // Start SPI transaction
+        bool GC9A01ADisplay::next_flush_rect_(FlushRect &rect)
+        {
+            // Takes the next rectangle of dirty tiles and clears its bits.
+            // Adjacent dirty tiles in a tile row form a span, and tile rows with the same span are merged
+            // vertically, so each rectangle costs one address window followed by one long RAMWR burst.
+            for (uint16_t ty = 0; ty < GC9A01A_TILE_ROWS; ty++)
+            {
+                uint16_t mask = this->dirty_tiles_[ty];
+                if (mask == 0)
+                    continue;
+
+                // First run of consecutive dirty tiles in this tile row
+                uint16_t tx1 = 0;
+                while (!(mask & (1 << tx1)))
+                    tx1++;
+                uint16_t tx2 = tx1;
+                while (tx2 + 1 < GC9A01A_TILE_COLS && (mask & (1 << (tx2 + 1))))
+                    tx2++;
+                uint16_t run = ((1 << (tx2 + 1)) - 1) & ~((1 << tx1) - 1);
+
+                // Grow the rectangle downwards while the next tile rows contain the same run
+                uint16_t ty2 = ty;
+                this->dirty_tiles_[ty] &= ~run;
+                while (ty2 + 1 < GC9A01A_TILE_ROWS && (this->dirty_tiles_[ty2 + 1] & run) == run)
+                {
+                    ty2++;
+                    this->dirty_tiles_[ty2] &= ~run;
+                }
 
-            uint8_t color_high = color >> 8;  // Extract high byte of RGB565
-            uint8_t color_low = color & 0xFF; // Extract low byte of RGB565
+                rect.x1 = tx1 * GC9A01A_TILE_SIZE;
+                rect.x2 = std::min<uint16_t>((tx2 + 1) * GC9A01A_TILE_SIZE, GC9A01A_WIDTH) - 1;
+                rect.y1 = ty * GC9A01A_TILE_SIZE;
+                rect.y2 = std::min<uint16_t>((ty2 + 1) * GC9A01A_TILE_SIZE, GC9A01A_HEIGHT) - 1;
+                return true;
+            }
+            return false;
+        }
 
-            for (uint32_t i = 0; i < count; i++) // Repeat for each pixel
+        uint32_t GC9A01ADisplay::tile_hash_(uint16_t tx, uint16_t ty)
+        {
+            // FNV-1a over 32-bit words of the tile's RGB565 content. INDEXED8 tiles are hashed through the
+            // palette, since fill() rebuilds it and the same index can stand for another color next frame.
+            const uint16_t x1 = tx * GC9A01A_TILE_SIZE;
+            const uint16_t y1 = ty * GC9A01A_TILE_SIZE;
+            const uint16_t y2 = std::min<uint16_t>(y1 + GC9A01A_TILE_SIZE, GC9A01A_HEIGHT);
+            uint32_t hash = 0x811C9DC5;
+            for (uint16_t y = y1; y < y2; y++)
             {
-                this->write_byte(color_high); // Send high byte
-                this->write_byte(color_low);  // Send low byte
+                if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+                {
+                    const uint8_t *row = this->buffer_ + y * GC9A01A_WIDTH + x1;
+                    for (uint16_t i = 0; i < GC9A01A_TILE_SIZE; i += 2)
+                        hash = (hash ^ (this->palette_[row[i]] | (uint32_t(this->palette_[row[i + 1]]) << 16))) * 16777619;
+                }
+                else
+                {
+                    const uint8_t *row = this->buffer_ + (y * GC9A01A_WIDTH + x1) * 2;
+                    for (uint16_t i = 0; i < GC9A01A_TILE_SIZE * 2; i += 4)
+                    {
+                        uint32_t word;
+                        memcpy(&word, row + i, sizeof(word));
+                        hash = (hash ^ word) * 16777619;
+                    }
+                }
             }
+            return hash != 0 ? hash : 1;
+        }
+
+        void GC9A01ADisplay::skip_unchanged_tiles_()
+        {
+            // Drops dirty tiles whose content matches what was last sent, so a redrawn but unchanged
+            // screen costs no SPI traffic at all
+            if (!this->skip_unchanged_)
+                return;
 
-            this->disable_(); // End SPI transaction
+            bool dirty = false;
+            bool changed = false;
+            for (uint16_t ty = 0; ty < GC9A01A_TILE_ROWS; ty++)
+            {
+                uint16_t mask = this->dirty_tiles_[ty];
+                if (mask == 0)
+                    continue;
+                dirty = true;
+                for (uint16_t tx = 0; tx < GC9A01A_TILE_COLS; tx++)
+                {
+                    if (!(mask & (1 << tx)))
+                        continue;
+                    const uint32_t hash = this->tile_hash_(tx, ty);
+                    uint32_t &shown = this->tile_hashes_[ty * GC9A01A_TILE_COLS + tx];
+                    if (hash == shown)
+                        mask &= ~(1 << tx);
+                    else
+                        shown = hash;
+                }
+                this->dirty_tiles_[ty] = mask;
+                changed |= mask != 0;
+            }
+
+            if (dirty && !changed)
+            {
+                this->frames_skipped_++;
+                this->stats_.skipped++;
+            }
         }
 
-        uint16_t GC9A01ADisplay::color_to_565_(Color color)
+        void GC9A01ADisplay::forget_tiles_()
+        {
+            // Panel content no longer follows the tile hashes (scrolled, or rows skipped in partial mode)
+            memset(this->tile_hashes_, 0, sizeof(this->tile_hashes_));
+        }
+
+        void GC9A01ADisplay::send_rows_(const FlushRect &rect, uint16_t y1, uint16_t y2)
         {
-            // Use the same RGB565 conversion logic as ESPHome's official ColorUtil::color_to_565()
-            // This ensures consistency with other ESPHome display components
-            uint16_t red_color = (color.red * 31) / 255;     // Scale 8-bit red to 5-bit (0-31)
-            uint16_t green_color = (color.green * 63) / 255; // Scale 8-bit green to 6-bit (0-63)
-            uint16_t blue_color = (color.blue * 31) / 255;   // Scale 8-bit blue to 5-bit (0-31)
+            // Sends rows y1..y2 of a rectangle, band by band, each band clipped to the round glass and
+            // sent with one address window and one RAMWR burst. Rows are gathered into the staging strip
+            // first, so a narrow rectangle still goes out as a few large transfers.
+            for (uint16_t band = y1, band_end; band <= y2; band = band_end + 1)
+            {
+                band_end = this->band_end_(band, y2);
+                // Rows the panel does not show in partial mode
+                if (this->partial_active_ && (band_end < this->partial_y1_ || band > this->partial_y2_))
+                    continue;
+                uint16_t x1 = rect.x1;
+                uint16_t x2 = rect.x2;
+                if (!this->clip_to_round_(x1, x2, band, band_end))
+                    continue;
+
+                this->set_addr_window_(x1, band, x2, band_end);
+
+                const uint16_t row_pixels = x2 - x1 + 1;
+                const size_t row_bytes = row_pixels * 2;
+                const bool as_is = this->buffer_format_ == BUFFER_FORMAT_RGB565 && this->pixel_mode_ == PIXEL_MODE_RGB565;
+                this->begin_stream_(); // Pixel data follows RAMWR
+                if (!as_is)
+                {
+                    // Palette indices and RGB666 are expanded here, into the strip or one row at a time
+                    uint8_t line[GC9A01A_WIDTH * 3];
+                    size_t used = 0;
+                    for (uint16_t y = band; y <= band_end; y++)
+                    {
+                        const uint32_t pos = y * GC9A01A_WIDTH + x1;
+                        if (this->strip_buffer_ == nullptr)
+                        {
+                            this->stream_(line, this->encode_row_(line, pos, row_pixels));
+                            continue;
+                        }
+                        used += this->encode_row_(this->strip_buffer_ + used, pos, row_pixels);
+                    }
+                    if (used > 0)
+                        this->stream_(this->strip_buffer_, used);
+                }
+                else if (this->strip_buffer_ == nullptr)
+                {
+                    for (uint16_t y = band; y <= band_end; y++)
+                        this->stream_(this->buffer_ + (y * GC9A01A_WIDTH + x1) * 2, row_bytes);
+                }
+                else
+                {
+                    size_t used = 0;
+                    for (uint16_t y = band; y <= band_end; y++)
+                    {
+                        memcpy(this->strip_buffer_ + used, this->buffer_ + (y * GC9A01A_WIDTH + x1) * 2, row_bytes);
+                        used += row_bytes;
+                    }
+                    this->stream_(this->strip_buffer_, used);
+                }
+                this->end_stream_();
+                this->count_pixels_(row_pixels * (band_end - band + 1));
+            }
+        }
+
+        void GC9A01ADisplay::flush_()
+        {
+            // Pushes every dirty tile of the framebuffer to the panel before returning
+            if (this->buffer_ == nullptr)
+                return;
+
+            const uint32_t start = micros();
+            const uint32_t pixels = this->stats_.pixels;
+            this->palette_compact_tried_ = false;
+            this->skip_unchanged_tiles_();
+            FlushRect rect;
+            while (this->next_flush_rect_(rect))
+                this->send_rows_(rect, rect.y1, rect.y2);
+            if (this->stats_.pixels != pixels)
+                this->record_frame_(micros() - start);
+        }
 
-            // RGB565 format: RRRRR GGGGGG BBBBB
+        void GC9A01ADisplay::read_id_()
+        {
+            // RDDID: manufacturer, version and driver ID (reads as 0x000000 or 0xFFFFFF when MISO is not wired)
+            uint8_t id[3];
+            this->dc_pin_->digital_write(false);
+            this->enable_();
+            this->write_byte(GC9A01A_RDDID);
+            this->dc_pin_->digital_write(true);
+            this->read_array(id, sizeof(id));
+            this->disable_();
+            this->display_id_ = (id[0] << 16) | (id[1] << 8) | id[2];
+        }
+
+        void GC9A01ADisplay::tune_data_rate_()
+        {
+            // Steps the clock up from the configured rate while the test pattern keeps reading back intact.
+            // A rate only counts as passing after GC9A01A_TUNE_ROUNDS different patterns, against a rate that
+            // passes just by luck. The highest passing rate is then kept only if it also survives
+            // GC9A01A_TUNE_CONFIRM_ROUNDS further patterns, as margin for temperature and supply drift;
+            // otherwise the step below it is used (never less than the configured rate).
+            const uint32_t configured = this->data_rate_;
+            uint32_t best = 0;
+            uint32_t below_best = configured;
+            for (uint32_t rate : GC9A01A_TUNE_RATES)
+            {
+                if (rate < configured)
+                    continue;
+                bool stable = true;
+                for (uint8_t round = 0; round < GC9A01A_TUNE_ROUNDS && stable; round++)
+                    stable = this->verify_data_rate_(rate, round);
+                if (!stable)
+                {
+                    ESP_LOGD(TAG, "SPI clock calibration: %u Hz failed", (unsigned) rate);
+                    break;
+                }
+                if (best != 0)
+                    below_best = best;
+                best = rate;
+            }
+
+            if (best == 0)
+            {
+                // Nothing reads back, most likely because MISO is not connected
+                ESP_LOGW(TAG, "SPI clock calibration failed, keeping %u Hz", (unsigned) configured);
+                this->set_spi_rate_(configured);
+                return;
+            }
+
+            bool confirmed = true;
+            for (uint8_t round = GC9A01A_TUNE_ROUNDS; round < GC9A01A_TUNE_ROUNDS + GC9A01A_TUNE_CONFIRM_ROUNDS && confirmed;
+                 round++)
+                confirmed = this->verify_data_rate_(best, round);
+            const uint32_t chosen = confirmed ? best : below_best;
+            if (confirmed)
+                ESP_LOGI(TAG, "SPI clock calibrated to %u Hz (confirmed over %u more patterns)", (unsigned) chosen,
+                         GC9A01A_TUNE_CONFIRM_ROUNDS);
+            else
+                ESP_LOGI(TAG, "SPI clock calibrated to %u Hz (%u Hz failed the confirming patterns)",
+                         (unsigned) chosen, (unsigned) best);
+            this->set_spi_rate_(chosen);
+            this->data_rate_tuned_ = true;
+        }
+
+        bool GC9A01ADisplay::verify_data_rate_(uint32_t rate, uint8_t round)
+        {
+            // Test pattern with alternating, inverted neighbours. Red and blue are always equal, so the result
+            // does not depend on the MADCTL BGR bit.
+            uint8_t pattern[GC9A01A_TUNE_PIXELS * 3];
+            uint8_t expected[GC9A01A_TUNE_PIXELS][2];
+            size_t length = 0;
+            for (uint16_t i = 0; i < GC9A01A_TUNE_PIXELS; i++)
+            {
+                uint8_t red_blue = (i * 7 + round * 13) & 0x1F;
+                uint8_t green = (i * 11 + round * 29) & 0x3F;
+                if (i & 1)
+                {
+                    red_blue ^= 0x1F;
+                    green ^= 0x3F;
+                }
+                expected[i][0] = red_blue;
+                expected[i][1] = green;
+                length += this->encode_565_(pattern + length, (red_blue << 11) | (green << 5) | red_blue);
+            }
+
+            this->set_spi_rate_(rate);
+            this->set_addr_window_(0, 0, GC9A01A_TUNE_PIXELS - 1, 0);
+            this->begin_stream_();
+            this->stream_(pattern, length);
+            this->end_stream_();
+
+            // RAMRD returns one dummy byte, then 3 bytes per pixel with the color in the upper bits
+            uint8_t readback[1 + GC9A01A_TUNE_PIXELS * 3];
+            this->set_spi_rate_(GC9A01A_READ_DATA_RATE);
+            this->set_addr_window_(0, 0, GC9A01A_TUNE_PIXELS - 1, 0);
+            this->dc_pin_->digital_write(false);
+            this->enable_();
+            this->write_byte(GC9A01A_RAMRD);
+            this->dc_pin_->digital_write(true);
+            this->read_array(readback, sizeof(readback));
+            this->disable_();
+
+            for (uint16_t i = 0; i < GC9A01A_TUNE_PIXELS; i++)
+            {
+                const uint8_t *pixel = readback + 1 + i * 3;
+                if ((pixel[0] >> 3) != expected[i][0] || (pixel[1] >> 2) != expected[i][1] ||
+                    (pixel[2] >> 3) != expected[i][0])
+                    return false;
+            }
+            return true;
+        }
+
+        void GC9A01ADisplay::set_spi_rate_(uint32_t rate)
+        {
+            // The SPI bus applies the rate when the device registers, so re-register with the new one
+            if (this->data_rate_ == rate)
+                return;
+            this->spi_teardown();
+            this->data_rate_ = rate;
+            this->spi_setup();
+        }
+
+        void GC9A01ADisplay::record_frame_(uint32_t flush_us)
+        {
+            if (!this->stats_enabled_)
+                return;
+            FrameStats &stats = this->stats_;
+            stats.frames++;
+            stats.flush_us_min = std::min(stats.flush_us_min, flush_us);
+            stats.flush_us_total += flush_us;
+            stats.samples[stats.sample_pos] = flush_us;
+            stats.sample_pos = (stats.sample_pos + 1) % GC9A01A_STATS_SAMPLES;
+            stats.sample_count = std::min<uint8_t>(stats.sample_count + 1, GC9A01A_STATS_SAMPLES);
+        }
+
+        void GC9A01ADisplay::take_stats(FrameStats &stats)
+        {
+            stats = this->stats_;
+            this->stats_ = FrameStats{};
+        }
+
+        uint16_t GC9A01ADisplay::color_to_565_(Color color)
+        {
+            // RGB565 format: RRRRR GGGGGG BBBBB, taking the upper bits of each 8-bit channel.
             // Red: bits 15-11, Green: bits 10-5, Blue: bits 4-0
-            return (red_color << 11) | (green_color << 5) | blue_color;
+            return ((color.red & 0xF8) << 8) | ((color.green & 0xFC) << 3) | (color.blue >> 3);
+        }
+
+        size_t HOT GC9A01ADisplay::encode_565_(uint8_t *dst, uint16_t color)
+        {
+            // Writes one pixel in the interface format and returns its size
+            if (this->pixel_mode_ == PIXEL_MODE_RGB666)
+            {
+                dst[0] = (color >> 8) & 0xF8; // Red, 5 bits in the upper 6 of the byte
+                dst[1] = (color >> 3) & 0xFC; // Green, 6 bits
+                dst[2] = color << 3;          // Blue, 5 bits in the upper 6 of the byte
+                return 3;
+            }
+            dst[0] = color >> 8;
+            dst[1] = color & 0xFF;
+            return 2;
+        }
+
+        size_t GC9A01ADisplay::encode_row_(uint8_t *dst, uint32_t pos, uint16_t count)
+        {
+            // Expands count framebuffer pixels starting at pixel pos into interface bytes
+            uint8_t *out = dst;
+            if (this->buffer_format_ == BUFFER_FORMAT_INDEXED8)
+            {
+                const uint8_t *src = this->buffer_ + pos;
+                for (uint16_t i = 0; i < count; i++)
+                    out += this->encode_565_(out, this->palette_[src[i]]);
+            }
+            else
+            {
+                const uint8_t *src = this->buffer_ + pos * 2;
+                for (uint16_t i = 0; i < count; i++)
+                    out += this->encode_565_(out, (src[i * 2] << 8) | src[i * 2 + 1]);
+            }
+            return out - dst;
+        }
+
+        void GC9A01ADisplay::reset_palette_()
+        {
+            memset(this->palette_slot_index_, 0, GC9A01A_PALETTE_SLOTS * sizeof(uint16_t));
+            this->palette_size_ = 0;
+            this->palette_slots_used_ = 0;
+            this->last_valid_ = false;
+            // The next overflow is logged again
+            this->palette_overflow_ = false;
+        }
+
+        bool GC9A01ADisplay::compact_palette_()
+        {
+            // Without a fill() the palette is never rebuilt (LVGL only redraws what changed), so once it is
+            // full the entries no pixel of the framebuffer uses any more are dropped and the rest renumbered.
+            // Colors stay the same, and so do the tile hashes. At most one scan per flush, as it costs a pass
+            // over the whole framebuffer.
+            if (this->palette_compact_tried_)
+                return false;
+            this->palette_compact_tried_ = true;
+
+            const uint32_t pixels = GC9A01A_WIDTH * GC9A01A_HEIGHT;
+            bool used[GC9A01A_PALETTE_SIZE] = {};
+            for (uint32_t i = 0; i < pixels; i++)
+                used[this->buffer_[i]] = true;
+
+            uint8_t remap[GC9A01A_PALETTE_SIZE];
+            uint16_t kept = 0;
+            for (uint16_t i = 0; i < this->palette_size_; i++)
+            {
+                if (used[i])
+                {
+                    remap[i] = kept;
+                    this->palette_[kept++] = this->palette_[i];
+                }
+            }
+            if (kept == this->palette_size_)
+                return false;
+
+            for (uint32_t i = 0; i < pixels; i++)
+                this->buffer_[i] = remap[this->buffer_[i]];
+
+            // Rebuild the lookup table, which also drops the cached nearest entries
+            const uint16_t size = kept;
+            this->reset_palette_();
+            for (uint16_t i = 0; i < size; i++)
+                this->palette_index_(this->palette_[i]);
+            ESP_LOGD(TAG, "Palette compacted to %u colors", size);
+            return true;
+        }
+
+        uint8_t HOT GC9A01ADisplay::palette_index_(uint16_t color)
+        {
+            // Runs of one color (text, fills, widgets) hit the last lookup
+            if (this->last_valid_ && this->last_color_ == color)
+                return this->last_index_;
+
+            // Linear probing; the table is twice the palette size, so there is always a free slot
+            uint16_t slot = uint16_t(color * 40503u) >> 7;
+            while (this->palette_slot_index_[slot] != 0 && this->palette_slot_color_[slot] != color)
+                slot = (slot + 1) & (GC9A01A_PALETTE_SLOTS - 1);
+
+            uint8_t index;
+            if (this->palette_slot_index_[slot] != 0)
+            {
+                index = this->palette_slot_index_[slot] - 1;
+            }
+            else
+            {
+                if (this->palette_size_ < GC9A01A_PALETTE_SIZE)
+                {
+                    index = this->palette_size_++;
+                    this->palette_[index] = color;
+                }
+                else if (this->compact_palette_())
+                {
+                    // Entries of colors that are no longer on screen were dropped (the table was rebuilt,
+                    // so this color gets a fresh slot below)
+                    return this->palette_index_(color);
+                }
+                else
+                {
+                    // Palette full: use the nearest entry
+                    if (!this->palette_overflow_)
+                    {
+                        ESP_LOGW(TAG, "More than %u colors in one frame, using nearest palette entries",
+                                 GC9A01A_PALETTE_SIZE);
+                        this->palette_overflow_ = true;
+                    }
+                    index = 0;
+                    uint32_t best = UINT32_MAX;
+                    for (uint16_t i = 0; i < GC9A01A_PALETTE_SIZE; i++)
+                    {
+                        const int32_t dr = int32_t(color >> 11) - (this->palette_[i] >> 11);
+                        const int32_t dg = int32_t((color >> 5) & 0x3F) - ((this->palette_[i] >> 5) & 0x3F);
+                        const int32_t db = int32_t(color & 0x1F) - (this->palette_[i] & 0x1F);
+                        const uint32_t distance = 4 * dr * dr + dg * dg + 4 * db * db;
+                        if (distance < best)
+                        {
+                            best = distance;
+                            index = i;
+                        }
+                    }
+                }
+                // Keep the table at most 3/4 full so probing stays short
+                if (this->palette_slots_used_ < GC9A01A_PALETTE_SLOTS * 3 / 4)
+                {
+                    this->palette_slot_color_[slot] = color;
+                    this->palette_slot_index_[slot] = index + 1;
+                    this->palette_slots_used_++;
+                }
+            }
+
+            this->last_color_ = color;
+            this->last_index_ = index;
+            this->last_valid_ = true;
+            return index;
         }
 
         void GC9A01ADisplay::enable_()
@@ -4,6 +4,7 @@
 #include "esphome/components/spi/spi.h"
 #include "esphome/components/display/display_buffer.h"
 #include "esphome/core/gpio.h"
+#include "esphome/components/display_transport/display_transport.h"
 
 namespace esphome
 {
@@ -14,9 +15,78 @@ namespace esphome
         static const uint16_t GC9A01A_WIDTH = 240;
         static const uint16_t GC9A01A_HEIGHT = 240;
 
+        // Dirty tracking granularity for the off-screen framebuffer (15x15 tiles on the 240x240 panel)
+        static const uint16_t GC9A01A_TILE_SIZE = 16;
+        static const uint16_t GC9A01A_TILE_COLS = (GC9A01A_WIDTH + GC9A01A_TILE_SIZE - 1) / GC9A01A_TILE_SIZE;
+        static const uint16_t GC9A01A_TILE_ROWS = (GC9A01A_HEIGHT + GC9A01A_TILE_SIZE - 1) / GC9A01A_TILE_SIZE;
+
+        // Staging strip in DMA-capable RAM: one full tile row of RGB565 pixels (a band of 8 RGB666 rows fits too)
+        static const uint32_t GC9A01A_STRIP_BYTES = GC9A01A_WIDTH * GC9A01A_TILE_SIZE * 2;
+        // Rows per address window when clipping to the round glass (a strip always holds a whole band)
+        static const uint16_t GC9A01A_CLIP_BAND_ROWS = 8;
+        // Time the ASYNC transport may spend pushing strips per loop() call
+        static const uint32_t GC9A01A_FLUSH_BUDGET_US = 4000;
+        // SPI clock calibration: a small test pattern is written at each candidate rate and read back
+        // with RAMRD at a safe read rate, in the invisible top-left corner of panel RAM
+        static const uint16_t GC9A01A_TUNE_PIXELS = 32;
+        static const uint8_t GC9A01A_TUNE_ROUNDS = 4;
+        // Extra patterns the highest passing rate must survive before it is kept
+        static const uint8_t GC9A01A_TUNE_CONFIRM_ROUNDS = 32;
+        static const uint32_t GC9A01A_READ_DATA_RATE = 5000000;
+        // INDEXED8 palette, and the open-addressing table mapping RGB565 colors to palette entries
+        static const uint16_t GC9A01A_PALETTE_SIZE = 256;
+        static const uint16_t GC9A01A_PALETTE_SLOTS = 512;
+
+        enum TransportMode
+        {
+            TRANSPORT_BLOCKING = 0, // update() pushes the whole frame before returning
+            TRANSPORT_ASYNC = 1,    // update() returns at once, loop() streams the frame strip by strip
+        };
+
+        // Flush statistics, collected while the metrics sensor platform is configured
+        static const uint8_t GC9A01A_STATS_SAMPLES = 64;
+        struct FrameStats
+        {
+            uint32_t frames{0}; // Flushes that sent pixels
+            uint32_t flush_us_min{UINT32_MAX};
+            uint64_t flush_us_total{0};
+            uint32_t bytes{0}; // Pixel data sent over SPI
+            uint32_t pixels{0};
+            uint32_t stalls{0};                        // update() calls deferred by a frame still in flight
+            uint32_t skipped{0};                       // Flushes dropped because every dirty tile was unchanged
+            uint32_t samples[GC9A01A_STATS_SAMPLES]{}; // Most recent flush times in us, for percentiles
+            uint8_t sample_count{0};
+            uint8_t sample_pos{0};
+        };
+
+        // Pixel format on the SPI interface (COLMOD)
+        enum PixelMode
+        {
+            PIXEL_MODE_RGB565 = 0, // 2 bytes per pixel
+            PIXEL_MODE_RGB666 = 1, // 3 bytes per pixel, upper 6 bits of each byte
+        };
+
+        // Pixel format of the off-screen framebuffer
+        enum BufferFormat
+        {
+            BUFFER_FORMAT_RGB565 = 0,   // 2 bytes per pixel, big-endian (115.2 KB)
+            BUFFER_FORMAT_INDEXED8 = 1, // 1 byte per pixel into an adaptive RGB565 palette (57.6 KB)
+        };
+
+        // Rectangle of dirty tiles, in pixels (inclusive)
+        struct FlushRect
+        {
+            uint16_t x1;
+            uint16_t y1;
+            uint16_t x2;
+            uint16_t y2;
+        };
+
         // GC9A01A Commands
         static const uint8_t GC9A01A_SWRESET = 0x01; // Software Reset
+        static const uint8_t GC9A01A_RDDID = 0x04;   // Read Display Identification
         static const uint8_t GC9A01A_SLPOUT = 0x11;  // Sleep Out
+        static const uint8_t GC9A01A_PTLON = 0x12;   // Partial Mode On
         static const uint8_t GC9A01A_NORON = 0x13;   // Normal Display Mode On
         static const uint8_t GC9A01A_INVOFF = 0x20;  // Display Inversion Off
         static const uint8_t GC9A01A_INVON = 0x21;   // Display Inversion On
@@ -25,7 +95,11 @@ namespace esphome
         static const uint8_t GC9A01A_CASET = 0x2A;   // Column Address Set
         static const uint8_t GC9A01A_RASET = 0x2B;   // Row Address Set
         static const uint8_t GC9A01A_RAMWR = 0x2C;   // Memory Write
+        static const uint8_t GC9A01A_RAMRD = 0x2E;   // Memory Read
+        static const uint8_t GC9A01A_PTLAR = 0x30;   // Partial Area
+        static const uint8_t GC9A01A_VSCRDEF = 0x33; // Vertical Scrolling Definition
         static const uint8_t GC9A01A_MADCTL = 0x36;  // Memory Access Control
+        static const uint8_t GC9A01A_VSCRSADD = 0x37; // Vertical Scrolling Start Address
         static const uint8_t GC9A01A_COLMOD = 0x3A;  // Pixel Format Set
 
         // Memory Access Control bits
@@ -38,34 +112,117 @@ namespace esphome
 
         class GC9A01ADisplay : public display::DisplayBuffer,
                                public spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW,
-                                                     spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_40MHZ>
+                                                     spi::CLOCK_PHASE_LEADING, spi::DATA_RATE_40MHZ>,
+                               public display_transport::SPIDisplayTransport,
+                               public display_transport::BenchmarkTarget
         {
         public:
             void set_dc_pin(GPIOPin *dc_pin) { this->dc_pin_ = dc_pin; }
             void set_reset_pin(GPIOPin *reset_pin) { this->reset_pin_ = reset_pin; }
             void set_backlight_pin(GPIOPin *backlight_pin) { this->backlight_pin_ = backlight_pin; }
+            void set_transport_mode(TransportMode mode) { this->transport_mode_ = mode; }
+            void set_use_framebuffer(bool use_framebuffer) { this->use_framebuffer_ = use_framebuffer; }
+            void set_pixel_mode(PixelMode mode) { this->pixel_mode_ = mode; }
+            void set_buffer_format(BufferFormat format) { this->buffer_format_ = format; }
+            void set_auto_tune_data_rate(bool auto_tune) { this->auto_tune_data_rate_ = auto_tune; }
+            void set_skip_unchanged(bool skip_unchanged) { this->skip_unchanged_ = skip_unchanged; }
+
+            // Flushes that sent nothing because the redrawn frame matched what the panel already shows
+            uint32_t get_frames_skipped() const { return this->frames_skipped_; }
+
+            // True while an ASYNC frame is still being streamed to the panel
+            bool is_frame_in_flight() const { return this->frame_in_flight_; }
+
+            // Hardware vertical scrolling: rows between the fixed top and bottom areas wrap around in panel RAM.
+            // scroll_by() moves that content up (positive) or down with one register write; the framebuffer is
+            // rotated along with it, so only the newly exposed rows have to be drawn. Call it outside the page
+            // lambda. Inside the scroll area pixels are not clipped to the round glass, as rows move across it.
+            void set_scroll_area(uint16_t top_fixed, uint16_t bottom_fixed);
+            void scroll_by(int16_t rows);
+            void reset_scroll();
+            uint16_t get_scroll_offset() const { return this->scroll_offset_; }
+
+            // Flush statistics for the metrics sensors: take_stats() returns the current window and starts a new one
+            void set_stats_enabled(bool enabled) { this->stats_enabled_ = enabled; }
+            void take_stats(FrameStats &stats);
+
+            // Partial display mode: only rows y1..y2 are refreshed by the panel, and flushes skip everything else.
+            // clear_partial_area() returns to normal mode and resends the whole screen with the next flush.
+            void set_partial_area(uint16_t y1, uint16_t y2);
+            void clear_partial_area();
 
             // PollingComponent interface
             void setup() override;
             void update() override;
+            void loop() override;
             void dump_config() override;
             float get_setup_priority() const override;
 
             // DisplayBuffer interface
             void fill(Color color) override;
             void draw_absolute_pixel_internal(int x, int y, Color color) override;
+            // Whole rectangles of RGB565 pixels (LVGL flush path): copied into the framebuffer,
+            // or without a framebuffer sent straight to the panel in one CASET/RASET/RAMWR burst
+            void draw_pixels_at(int x_start, int y_start, int w, int h, const uint8_t *ptr, display::ColorOrder order,
+                                display::ColorBitness bitness, bool big_endian, int x_offset, int y_offset,
+                                int x_pad) override;
             int get_height_internal() override;
             int get_width_internal() override;
             display::DisplayType get_display_type() override;
 
+            // BenchmarkTarget interface
+            void benchmark_flush() override { this->commit_dirty_(); }
+            bool benchmark_busy() override { return this->frame_in_flight_; }
+            display_transport::SPIDisplayTransport *benchmark_transport() override { return this; }
+
         protected:
+            // SPIDisplayTransport bus access
+            void transport_enable_() override { this->enable_(); }
+            void transport_disable_() override { this->disable_(); }
+            void transport_write_(const uint8_t *data, size_t length) override { this->write_array(data, length); }
+
             void init_display_();
             void set_addr_window_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
-            void write_command_(uint8_t cmd);
-            void write_data_(uint8_t data);
-            void write_data_16_(uint16_t data);
+            void write_pixel_(uint16_t color);
             void write_color_(uint16_t color, uint32_t count);
+            bool clip_to_round_(uint16_t &x1, uint16_t &x2, uint16_t y1, uint16_t y2);
+            uint16_t band_end_(uint16_t band, uint16_t y2);
+            uint16_t ram_row_(uint16_t y) const;
+            bool in_scroll_area_(uint16_t y) const
+            {
+                return this->scroll_rows_ != 0 && y >= this->scroll_top_ && y < this->scroll_top_ + this->scroll_rows_;
+            }
+            void drain_();
+            void mark_dirty_(int x, int y);
+            void mark_all_dirty_();
+            void mark_dirty_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+            void commit_dirty_();
+            bool next_flush_rect_(FlushRect &rect);
+            uint32_t tile_hash_(uint16_t tx, uint16_t ty);
+            void skip_unchanged_tiles_();
+            void forget_tiles_();
+            void send_rows_(const FlushRect &rect, uint16_t y1, uint16_t y2);
+            void flush_();
+            void start_async_frame_();
+            void finish_frame_();
+            void read_id_();
+            void tune_data_rate_();
+            bool verify_data_rate_(uint32_t rate, uint8_t round);
+            void set_spi_rate_(uint32_t rate);
+            void record_frame_(uint32_t flush_us);
+            void count_pixels_(uint32_t pixels)
+            {
+                this->stats_.pixels += pixels;
+                this->stats_.bytes += pixels * this->panel_bytes_();
+            }
             uint16_t color_to_565_(Color color);
+            size_t encode_565_(uint8_t *dst, uint16_t color);
+            size_t encode_row_(uint8_t *dst, uint32_t pos, uint16_t count);
+            void reset_palette_();
+            uint8_t palette_index_(uint16_t color);
+            bool compact_palette_();
+            uint8_t buffer_bytes_() const { return this->buffer_format_ == BUFFER_FORMAT_INDEXED8 ? 1 : 2; }
+            uint8_t panel_bytes_() const { return this->pixel_mode_ == PIXEL_MODE_RGB666 ? 3 : 2; }
             void enable_();
             void disable_();
 
@@ -73,7 +230,53 @@ namespace esphome
             GPIOPin *reset_pin_{nullptr};
             GPIOPin *backlight_pin_{nullptr};
             bool is_ready_{false};
-            uint32_t update_counter_{0}; // Counter to manage update intervals
+            uint32_t display_id_{0};
+            bool auto_tune_data_rate_{false};
+            bool data_rate_tuned_{false};
+
+            // One bit per tile column, one entry per tile row; set bits are flushed by update()
+            uint16_t dirty_tiles_[GC9A01A_TILE_ROWS]{};
+            // Hash of the content each tile had when it was last sent (0: unknown, always send)
+            uint32_t tile_hashes_[GC9A01A_TILE_ROWS * GC9A01A_TILE_COLS]{};
+            bool skip_unchanged_{true};
+            uint32_t frames_skipped_{0};
+
+            TransportMode transport_mode_{TRANSPORT_BLOCKING};
+            bool use_framebuffer_{true};
+            uint8_t *strip_buffer_{nullptr};
+            FlushRect flush_rect_{};
+            uint16_t flush_row_{0};
+            bool flush_rect_active_{false};
+            bool frame_in_flight_{false};
+            bool update_pending_{false};
+
+            PixelMode pixel_mode_{PIXEL_MODE_RGB565};
+            BufferFormat buffer_format_{BUFFER_FORMAT_RGB565};
+            // INDEXED8 only: palette entries in RGB565, and a hash table of (color, entry + 1) slots.
+            // Slots also cache the nearest entry for colors seen after the palette filled up.
+            uint16_t *palette_{nullptr};
+            uint16_t *palette_slot_color_{nullptr};
+            uint16_t *palette_slot_index_{nullptr};
+            uint16_t palette_size_{0};
+            uint16_t palette_slots_used_{0};
+            uint16_t last_color_{0};
+            uint8_t last_index_{0};
+            bool last_valid_{false};
+            bool palette_overflow_{false};
+            bool palette_compact_tried_{false};
+
+            // Vertical scroll area in display rows (scroll_rows_ == 0: no scroll area) and its current offset
+            uint16_t scroll_top_{0};
+            uint16_t scroll_rows_{0};
+            uint16_t scroll_offset_{0};
+            bool partial_active_{false};
+            uint16_t partial_y1_{0};
+            uint16_t partial_y2_{0};
+
+            bool stats_enabled_{false};
+            FrameStats stats_{};
+            uint32_t frame_start_us_{0};
+            uint32_t frame_start_pixels_{0};
         };
 
     } // namespace gc9a01a_display
@@ -0,0 +1,89 @@
+#include "gc9a01a_metrics.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome
+{
+    namespace gc9a01a_display
+    {
+
+        static const char *const TAG = "gc9a01a_display.metrics";
+
+        void GC9A01AMetrics::setup()
+        {
+            // Statistics are only collected while someone reads them
+            this->parent_->set_stats_enabled(true);
+            this->last_publish_ = millis();
+        }
+
+        void GC9A01AMetrics::update()
+        {
+            FrameStats stats;
+            this->parent_->take_stats(stats);
+
+            const uint32_t now = millis();
+            const float seconds = (now - this->last_publish_) / 1000.0f;
+            this->last_publish_ = now;
+            if (seconds <= 0.0f)
+                return;
+
+            const bool flushed = stats.frames > 0;
+
+            if (this->flush_time_min_sensor_ != nullptr)
+                this->flush_time_min_sensor_->publish_state(flushed ? stats.flush_us_min / 1000.0f : NAN);
+
+            if (this->flush_time_avg_sensor_ != nullptr)
+                this->flush_time_avg_sensor_->publish_state(flushed ? stats.flush_us_total / 1000.0f / stats.frames : NAN);
+
+            if (this->flush_time_p99_sensor_ != nullptr)
+            {
+                // Over the most recent GC9A01A_STATS_SAMPLES flushes of the window
+                float p99 = NAN;
+                if (stats.sample_count > 0)
+                {
+                    std::sort(stats.samples, stats.samples + stats.sample_count);
+                    const uint8_t index = std::min<uint8_t>(stats.sample_count - 1, (stats.sample_count * 99 + 99) / 100 - 1);
+                    p99 = stats.samples[index] / 1000.0f;
+                }
+                this->flush_time_p99_sensor_->publish_state(p99);
+            }
+
+            if (this->throughput_sensor_ != nullptr)
+                this->throughput_sensor_->publish_state(stats.bytes / seconds);
+
+            if (this->dirty_ratio_sensor_ != nullptr)
+            {
+                // Share of the screen sent per flush
+                const float screen = float(GC9A01A_WIDTH) * GC9A01A_HEIGHT;
+                this->dirty_ratio_sensor_->publish_state(flushed ? stats.pixels * 100.0f / (screen * stats.frames) : 0.0f);
+            }
+
+            if (this->stalls_sensor_ != nullptr)
+                this->stalls_sensor_->publish_state(stats.stalls);
+
+            if (this->fps_sensor_ != nullptr)
+                this->fps_sensor_->publish_state(stats.frames / seconds);
+
+            if (this->frames_skipped_sensor_ != nullptr)
+                this->frames_skipped_sensor_->publish_state(stats.skipped);
+        }
+
+        void GC9A01AMetrics::dump_config()
+        {
+            ESP_LOGCONFIG(TAG, "GC9A01A Metrics:");
+            LOG_UPDATE_INTERVAL(this);
+            LOG_SENSOR("  ", "Flush Time Min", this->flush_time_min_sensor_);
+            LOG_SENSOR("  ", "Flush Time Avg", this->flush_time_avg_sensor_);
+            LOG_SENSOR("  ", "Flush Time P99", this->flush_time_p99_sensor_);
+            LOG_SENSOR("  ", "Throughput", this->throughput_sensor_);
+            LOG_SENSOR("  ", "Dirty Ratio", this->dirty_ratio_sensor_);
+            LOG_SENSOR("  ", "Stalls", this->stalls_sensor_);
+            LOG_SENSOR("  ", "FPS", this->fps_sensor_);
+            LOG_SENSOR("  ", "Frames Skipped", this->frames_skipped_sensor_);
+        }
+
+    } // namespace gc9a01a_display
+} // namespace esphome
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/sensor/sensor.h"
+#include "gc9a01a_display.h"
+
+namespace esphome
+{
+    namespace gc9a01a_display
+    {
+
+        // Publishes the flush statistics of a GC9A01ADisplay once per update_interval.
+        // Every value covers the window since the previous publish.
+        class GC9A01AMetrics : public PollingComponent, public Parented<GC9A01ADisplay>
+        {
+        public:
+            void set_flush_time_min_sensor(sensor::Sensor *sensor) { this->flush_time_min_sensor_ = sensor; }
+            void set_flush_time_avg_sensor(sensor::Sensor *sensor) { this->flush_time_avg_sensor_ = sensor; }
+            void set_flush_time_p99_sensor(sensor::Sensor *sensor) { this->flush_time_p99_sensor_ = sensor; }
+            void set_throughput_sensor(sensor::Sensor *sensor) { this->throughput_sensor_ = sensor; }
+            void set_dirty_ratio_sensor(sensor::Sensor *sensor) { this->dirty_ratio_sensor_ = sensor; }
+            void set_stalls_sensor(sensor::Sensor *sensor) { this->stalls_sensor_ = sensor; }
+            void set_fps_sensor(sensor::Sensor *sensor) { this->fps_sensor_ = sensor; }
+            void set_frames_skipped_sensor(sensor::Sensor *sensor) { this->frames_skipped_sensor_ = sensor; }
+
+            void setup() override;
+            void update() override;
+            void dump_config() override;
+
+        protected:
+            sensor::Sensor *flush_time_min_sensor_{nullptr};
+            sensor::Sensor *flush_time_avg_sensor_{nullptr};
+            sensor::Sensor *flush_time_p99_sensor_{nullptr};
+            sensor::Sensor *throughput_sensor_{nullptr};
+            sensor::Sensor *dirty_ratio_sensor_{nullptr};
+            sensor::Sensor *stalls_sensor_{nullptr};
+            sensor::Sensor *fps_sensor_{nullptr};
+            sensor::Sensor *frames_skipped_sensor_{nullptr};
+            uint32_t last_publish_{0};
+        };
+
+    } // namespace gc9a01a_display
+} // namespace esphome
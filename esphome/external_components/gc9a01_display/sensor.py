@@ -0,0 +1,80 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+    UNIT_PERCENT,
+)
+
+from .display import GC9A01A, gc9a01a_ns
+
+GC9A01AMetrics = gc9a01a_ns.class_(
+    "GC9A01AMetrics", cg.PollingComponent, cg.Parented.template(GC9A01A)
+)
+
+CONF_DISPLAY_ID = "display_id"
+CONF_FLUSH_TIME_MIN = "flush_time_min"
+CONF_FLUSH_TIME_AVG = "flush_time_avg"
+CONF_FLUSH_TIME_P99 = "flush_time_p99"
+CONF_THROUGHPUT = "throughput"
+CONF_DIRTY_RATIO = "dirty_ratio"
+CONF_STALLS = "stalls"
+CONF_FPS = "fps"
+CONF_FRAMES_SKIPPED = "frames_skipped"
+
+UNIT_BYTES_PER_SECOND = "B/s"
+UNIT_FRAMES_PER_SECOND = "fps"
+
+
+def _metric_schema(unit, accuracy, icon):
+    return sensor.sensor_schema(
+        unit_of_measurement=unit,
+        accuracy_decimals=accuracy,
+        icon=icon,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+# Every value covers the window since the previous publish
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(GC9A01AMetrics),
+        cv.GenerateID(CONF_DISPLAY_ID): cv.use_id(GC9A01A),
+        cv.Optional(CONF_FLUSH_TIME_MIN): _metric_schema(UNIT_MILLISECOND, 2, "mdi:timer-outline"),
+        cv.Optional(CONF_FLUSH_TIME_AVG): _metric_schema(UNIT_MILLISECOND, 2, "mdi:timer-outline"),
+        cv.Optional(CONF_FLUSH_TIME_P99): _metric_schema(UNIT_MILLISECOND, 2, "mdi:timer-alert-outline"),
+        cv.Optional(CONF_THROUGHPUT): _metric_schema(UNIT_BYTES_PER_SECOND, 0, "mdi:transfer"),
+        cv.Optional(CONF_DIRTY_RATIO): _metric_schema(UNIT_PERCENT, 1, "mdi:select-all"),
+        # update() calls deferred because the previous ASYNC frame was still being sent
+        cv.Optional(CONF_STALLS): _metric_schema("", 0, "mdi:traffic-light"),
+        cv.Optional(CONF_FPS): _metric_schema(UNIT_FRAMES_PER_SECOND, 1, "mdi:speedometer"),
+        # Redrawn frames that matched the panel content and were not sent (skip_unchanged)
+        cv.Optional(CONF_FRAMES_SKIPPED): _metric_schema("", 0, "mdi:skip-next-outline"),
+    }
+).extend(cv.polling_component_schema("10s"))
+
+METRICS = {
+    CONF_FLUSH_TIME_MIN: "set_flush_time_min_sensor",
+    CONF_FLUSH_TIME_AVG: "set_flush_time_avg_sensor",
+    CONF_FLUSH_TIME_P99: "set_flush_time_p99_sensor",
+    CONF_THROUGHPUT: "set_throughput_sensor",
+    CONF_DIRTY_RATIO: "set_dirty_ratio_sensor",
+    CONF_STALLS: "set_stalls_sensor",
+    CONF_FPS: "set_fps_sensor",
+    CONF_FRAMES_SKIPPED: "set_frames_skipped_sensor",
+}
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await cg.register_parented(var, config[CONF_DISPLAY_ID])
+
+    for key, setter in METRICS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
@@ -1,23 +1,169 @@
-#include <sstream>
-#include <iostream>
+#include <cstring>
+#include <vector>
+
+constexpr uint32_t rgbToHex(uint8_t r, uint8_t g, uint8_t b)
+{
+    return ((uint32_t) r << 16) | ((uint32_t) g << 8) | b;
+}
 
 unsigned long esphomeColorToHex(esphome::Color color)
 {
-    return ((color.r & 0xff) << 16) + ((color.g & 0xff) << 8) + (color.b & 0xff);
+    return rgbToHex(color.r, color.g, color.b);
+}
+
+// Native LVGL color of a color known at compile time, e.g. constColor<0x272828>(); converted once
+template<uint32_t HEX> static lv_color_t constColor()
+{
+    static const lv_color_t color = lv_color_hex(HEX);
+    return color;
+}
+
+// Theme colors: every ESPHome Color global gets a slot keyed by its address, holding the converted lv_color_t.
+// It is converted on first use and again only when the color changes, so a style lambda only does a lookup:
+//   text_color: !lambda return themeColor(id(white_color));
+struct ThemeColor
+{
+    const esphome::Color* source;
+    uint32_t raw;
+    lv_color_t value;
+};
+
+static lv_color_t themeColor(const esphome::Color& color)
+{
+    // Plenty for colors.yaml; colors beyond that are converted on every call
+    static ThemeColor table[64];
+    const size_t mask = sizeof(table) / sizeof(table[0]) - 1;
+    size_t slot = ((uintptr_t) &color >> 2) & mask;
+    for (size_t probe = 0; probe <= mask; probe++, slot = (slot + 1) & mask)
+    {
+        ThemeColor& entry = table[slot];
+        if (entry.source == nullptr)
+        {
+            entry.source = &color;
+            entry.raw = color.raw_32;
+            entry.value = lv_color_make(color.r, color.g, color.b);
+        }
+        if (entry.source == &color)
+        {
+            if (entry.raw != color.raw_32)
+            {
+                entry.raw = color.raw_32;
+                entry.value = lv_color_make(color.r, color.g, color.b);
+            }
+            return entry.value;
+        }
+    }
+    return lv_color_make(color.r, color.g, color.b);
+}
+
+// FNV-1a, used to spot changed roller options and as key of the option table
+static uint32_t m5dialHash(const char* text, size_t length)
+{
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t) text[i];
+        hash *= 16777619UL;
+    }
+    return hash;
 }
 
-static std::vector<std::string> splitSelectValues(const char* lineToSplit)
+// The options of one roller, parsed once: a copy of the option string with every '\n' replaced by '\0',
+// so each option is a C string, and a hash table from option text to index.
+struct RollerOptions
 {
-    std::stringstream origStream;
-    origStream << lineToSplit;
-    std::vector<std::string> lineList;
-    std::string curLine;
-    while (std::getline(origStream, curLine))
+    lv_obj_t* roller = nullptr;
+    uint32_t optionsHash = 0;
+    size_t optionsLength = 0;
+    std::vector<char> text;
+    std::vector<uint16_t> starts; // start of every option in text
+    std::vector<uint16_t> slots;  // open addressing, option index + 1 (0 = empty)
+
+    void parse(const char* options, size_t length, uint32_t hash)
+    {
+        optionsHash = hash;
+        optionsLength = length;
+        text.assign(options, options + length);
+        text.push_back('\0');
+        starts.clear();
+        // Same numbering as LVGL: every line counts, only a trailing newline does not start an option
+        for (size_t i = 0; i < length; i++)
+        {
+            if (i == 0 || text[i - 1] == '\n')
+                starts.push_back(i);
+        }
+        for (char& c : text)
+        {
+            if (c == '\n')
+                c = '\0';
+        }
+
+        size_t size = 8;
+        while (size < starts.size() * 2)
+            size *= 2;
+        slots.assign(size, 0);
+        for (size_t index = 0; index < starts.size(); index++)
+        {
+            const char* option = &text[starts[index]];
+            size_t slot = m5dialHash(option, strlen(option)) & (size - 1);
+            while (slots[slot] != 0)
+                slot = (slot + 1) & (size - 1);
+            slots[slot] = index + 1;
+        }
+    }
+
+    int indexOf(const char* value, size_t length) const
+    {
+        if (slots.empty())
+            return -1;
+        size_t slot = m5dialHash(value, length) & (slots.size() - 1);
+        while (slots[slot] != 0)
+        {
+            const char* option = &text[starts[slots[slot] - 1]];
+            if (strncmp(option, value, length) == 0 && option[length] == '\0')
+                return slots[slot] - 1;
+            slot = (slot + 1) & (slots.size() - 1);
+        }
+        return -1;
+    }
+};
+
+// Cached options of a roller, re-parsed only when lv_roller_get_options() returns something different
+static const RollerOptions& rollerOptions(lv_obj_t* roller)
+{
+    static std::vector<RollerOptions> cache;
+    RollerOptions* entry = nullptr;
+    for (RollerOptions& candidate : cache)
     {
-        // Only add non empty lines.
-        if (!curLine.empty())
-            lineList.push_back(curLine);
+        if (candidate.roller == roller)
+            entry = &candidate;
+    }
+    if (entry == nullptr)
+    {
+        cache.emplace_back();
+        entry = &cache.back();
+        entry->roller = roller;
     }
 
-    return lineList;
-}
\ No newline at end of file
+    const char* options = lv_roller_get_options(roller);
+    const size_t length = strlen(options);
+    const uint32_t hash = m5dialHash(options, length);
+    if (entry->slots.empty() || hash != entry->optionsHash || length != entry->optionsLength)
+        entry->parse(options, length, hash);
+    return *entry;
+}
+
+// Index of the roller option with this text, or -1; for selected_index lambdas
+static int rollerOptionIndex(lv_obj_t* roller, const std::string& value)
+{
+    return rollerOptions(roller).indexOf(value.data(), value.size());
+}
+
+// Text of a roller option, "" if the index is out of range
+static const char* rollerOptionText(lv_obj_t* roller, int index)
+{
+    const RollerOptions& options = rollerOptions(roller);
+    if (index < 0 || index >= (int) options.starts.size())
+        return "";
+    return &options.text[options.starts[index]];
+}
@@ -1,16 +1,42 @@
-from esphome.components import custom
+from esphome import automation
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome.const import CONF_ID, CONF_TRIGGER_ID
 
 DEPENDENCIES = []
 
 switch_store_ns = cg.global_ns.namespace('switch_store')
 SwitchStore = switch_store_ns.class_('SwitchStore', cg.Component)
+SwitchChangedTrigger = switch_store_ns.class_(
+    'SwitchChangedTrigger', automation.Trigger.template(cg.std_string, cg.int_, cg.uint16)
+)
+
+CONF_ON_SWITCH_CHANGED = "on_switch_changed"
+CONF_SNAPSHOT = "snapshot"
+CONF_SNAPSHOT_SWITCHES = "snapshot_switches"
+CONF_SNAPSHOT_STRING_BYTES = "snapshot_string_bytes"
 
 CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(SwitchStore),
+    # Restore the last switch list from flash at boot, until Home Assistant sends a new one
+    cv.Optional(CONF_SNAPSHOT, default=True): cv.boolean,
+    # Size of the snapshot: switches, and bytes for their distinct names, entity_ids and devices
+    cv.Optional(CONF_SNAPSHOT_SWITCHES, default=128): cv.int_range(min=1, max=1024),
+    cv.Optional(CONF_SNAPSHOT_STRING_BYTES, default=8192): cv.int_range(min=256, max=65535),
+    # x = changed SwitchField bits, e.g. to redraw only the row of that entity_id
+    cv.Optional(CONF_ON_SWITCH_CHANGED): automation.validate_automation({
+        cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(SwitchChangedTrigger),
+    }),
 }).extend(cv.COMPONENT_SCHEMA)
 
-def to_code(config):
-    var = cg.new_Pvariable(config["id"])
-    yield cg.register_component(var, config)
\ No newline at end of file
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    cg.add(var.set_snapshot(config[CONF_SNAPSHOT]))
+    cg.add_define("SWITCH_STORE_SNAPSHOT_SWITCH_LIMIT", config[CONF_SNAPSHOT_SWITCHES])
+    cg.add_define("SWITCH_STORE_SNAPSHOT_STRING_LIMIT", config[CONF_SNAPSHOT_STRING_BYTES])
+    for conf in config.get(CONF_ON_SWITCH_CHANGED, []):
+        trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
+        await automation.build_automation(
+            trigger, [(cg.std_string, "entity_id"), (cg.int_, "index"), (cg.uint16, "x")], conf
+        )
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -14,3 +15,87 @@ inline std::vector<std::string> split(const std::string &str, char delimiter) {
   return result;
 }
 
+namespace esphome {
+namespace switch_store {
+
+// Non-owning view of part of a string; only valid as long as the string it points into
+struct Slice {
+  const char *data{nullptr};
+  size_t size{0};
+
+  Slice() = default;
+  Slice(const char *data, size_t size) : data(data), size(size) {}
+  Slice(const std::string &str) : data(str.data()), size(str.size()) {}  // NOLINT
+
+  bool empty() const { return this->size == 0; }
+  std::string str() const { return std::string(this->data, this->size); }
+
+  bool operator==(const char *other) const {
+    return strlen(other) == this->size && strncmp(this->data, other, this->size) == 0;
+  }
+
+  size_t find(char c) const {
+    const void *hit = memchr(this->data, c, this->size);
+    return hit != nullptr ? static_cast<const char *>(hit) - this->data : std::string::npos;
+  }
+
+  Slice substr(size_t pos, size_t len = std::string::npos) const {
+    if (pos > this->size)
+      pos = this->size;
+    if (len > this->size - pos)
+      len = this->size - pos;
+    return Slice(this->data + pos, len);
+  }
+
+  Slice trim() const {
+    size_t start = 0, end = this->size;
+    while (start < end && strchr(" \t\r\n", this->data[start]) != nullptr)
+      start++;
+    while (end > start && strchr(" \t\r\n", this->data[end - 1]) != nullptr)
+      end--;
+    return Slice(this->data + start, end - start);
+  }
+};
+
+// Walks the tokens between delimiters without copying them. The delimiter is a string, so multi-byte
+// separators such as "§" work. Like split(), an empty last token after a trailing delimiter is not returned.
+class Tokenizer {
+ public:
+  Tokenizer(Slice input, const char *delimiter)
+      : input_(input), delimiter_(delimiter), delimiter_size_(strlen(delimiter)) {}
+
+  bool next(Slice &token) {
+    if (this->pos_ >= this->input_.size)
+      return false;
+    const char *start = this->input_.data + this->pos_;
+    const char *end = this->input_.data + this->input_.size;
+    const char *hit = start;
+    while (hit + this->delimiter_size_ <= end && memcmp(hit, this->delimiter_, this->delimiter_size_) != 0)
+      hit++;
+    if (hit + this->delimiter_size_ > end) {
+      token = Slice(start, end - start);
+      this->pos_ = this->input_.size;
+    } else {
+      token = Slice(start, hit - start);
+      this->pos_ = hit - this->input_.data + this->delimiter_size_;
+    }
+    return true;
+  }
+
+ protected:
+  Slice input_;
+  const char *delimiter_;
+  size_t delimiter_size_;
+  size_t pos_{0};
+};
+
+// Calls f(token) for every token, see Tokenizer
+template<typename F> inline void split_each(Slice input, const char *delimiter, F f) {
+  Tokenizer tokens(input, delimiter);
+  Slice token;
+  while (tokens.next(token))
+    f(token);
+}
+
+}  // namespace switch_store
+}  // namespace esphome
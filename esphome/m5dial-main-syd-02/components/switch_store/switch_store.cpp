@@ -1,9 +1,681 @@
 #include "switch_store.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 namespace esphome {
 namespace switch_store {
 
-// nothing here
+static const char *const TAG = "switch_store";
+
+// Layout version in the low byte; a changed layout simply does not load
+static const uint32_t SNAPSHOT_MAGIC = 0x53575301UL;
+// Delay between a change and saving it, so a burst of changes is saved once
+static const uint32_t SNAPSHOT_DELAY_MS = 30000;
+
+static uint32_t hash_bytes(const char *str, size_t len) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= uint8_t(str[i]);
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+static uint32_t hash_ref(uint32_t ref) {
+  // Refs are offsets into one buffer, so spread them before masking
+  ref ^= ref >> 16;
+  ref *= 0x7feb352dUL;
+  ref ^= ref >> 15;
+  return ref;
+}
+
+// ---------------------------------------------------------------- StringPool
+
+size_t StringPool::slot_of_(const char *str, size_t len) const {
+  // Slot holding the string, or the empty slot where it belongs
+  const size_t mask = this->table_.size() - 1;
+  size_t slot = hash_bytes(str, len) & mask;
+  while (this->table_[slot] != 0) {
+    const char *candidate = this->data_ + this->table_[slot] - 1;
+    if (strncmp(candidate, str, len) == 0 && candidate[len] == '\0')
+      return slot;
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void StringPool::grow_() {
+  std::vector<uint32_t> old;
+  old.swap(this->table_);
+  this->table_.assign(old.empty() ? 64 : old.size() * 2, 0);
+  for (uint32_t entry : old) {
+    if (entry == 0)
+      continue;
+    const char *str = this->data_ + entry - 1;
+    this->table_[this->slot_of_(str, strlen(str))] = entry;
+  }
+}
+
+bool StringPool::reserve_(size_t size) {
+  if (size <= this->capacity_)
+    return true;
+  // Refs are offsets, so the arena can move when it grows
+  size_t capacity = std::max<size_t>(this->capacity_ * 2, 1024);
+  while (capacity < size)
+    capacity *= 2;
+  ExternalRAMAllocator<char> allocator(ExternalRAMAllocator<char>::ALLOW_FAILURE);
+  char *data = allocator.allocate(capacity);
+  if (data == nullptr) {
+    ESP_LOGE(TAG, "Could not grow the string pool to %u bytes", (unsigned) capacity);
+    return false;
+  }
+  if (this->data_ != nullptr) {
+    memcpy(data, this->data_, this->size_);
+    allocator.deallocate(this->data_, this->capacity_);
+  }
+  this->data_ = data;
+  this->capacity_ = capacity;
+  return true;
+}
+
+uint32_t StringPool::intern(const char *str, size_t len) {
+  // Kept at most half full, so probes stay short
+  if ((this->count_ + 1) * 2 > this->table_.size())
+    this->grow_();
+  const size_t slot = this->slot_of_(str, len);
+  if (this->table_[slot] != 0)
+    return this->table_[slot] - 1;
+  if (!this->reserve_(this->size_ + len + 1))
+    return UINT32_MAX;
+
+  const uint32_t ref = this->size_;
+  memcpy(this->data_ + ref, str, len);
+  this->data_[ref + len] = '\0';
+  this->size_ += len + 1;
+  this->table_[slot] = ref + 1;
+  this->count_++;
+  return ref;
+}
+
+uint32_t StringPool::find(const char *str, size_t len) const {
+  if (this->table_.empty())
+    return UINT32_MAX;
+  const size_t slot = this->slot_of_(str, len);
+  return this->table_[slot] != 0 ? this->table_[slot] - 1 : UINT32_MAX;
+}
+
+void StringPool::clear() {
+  if (this->data_ != nullptr) {
+    ExternalRAMAllocator<char> allocator(ExternalRAMAllocator<char>::ALLOW_FAILURE);
+    allocator.deallocate(this->data_, this->capacity_);
+  }
+  this->data_ = nullptr;
+  this->size_ = 0;
+  this->capacity_ = 0;
+  this->table_.clear();
+  this->count_ = 0;
+}
+
+// ---------------------------------------------------------------- RefIndex
+
+size_t RefIndex::slot_of_(uint32_t ref) const {
+  const size_t mask = this->slots_.size() - 1;
+  size_t slot = hash_ref(ref) & mask;
+  while (this->slots_[slot].value != SWITCH_STORE_NONE && this->slots_[slot].ref != ref)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+void RefIndex::grow_() {
+  std::vector<Slot> old;
+  old.swap(this->slots_);
+  this->slots_.assign(old.empty() ? 32 : old.size() * 2, Slot{0, SWITCH_STORE_NONE});
+  for (const Slot &entry : old) {
+    if (entry.value != SWITCH_STORE_NONE)
+      this->slots_[this->slot_of_(entry.ref)] = entry;
+  }
+}
+
+void RefIndex::put(uint32_t ref, uint16_t value) {
+  if ((this->count_ + 1) * 2 > this->slots_.size())
+    this->grow_();
+  Slot &slot = this->slots_[this->slot_of_(ref)];
+  if (slot.value == SWITCH_STORE_NONE)
+    this->count_++;
+  slot = Slot{ref, value};
+}
+
+uint16_t RefIndex::get(uint32_t ref) const {
+  if (this->slots_.empty() || ref == UINT32_MAX)
+    return SWITCH_STORE_NONE;
+  return this->slots_[this->slot_of_(ref)].value;
+}
+
+void RefIndex::clear() {
+  this->slots_.clear();
+  this->count_ = 0;
+}
+
+// ---------------------------------------------------------------- SwitchStore
+
+SwitchState SwitchStore::parse_state(const char *str, size_t len) {
+  if (len == 2 && strncmp(str, "on", 2) == 0)
+    return SWITCH_STATE_ON;
+  if (len == 3 && strncmp(str, "off", 3) == 0)
+    return SWITCH_STATE_OFF;
+  if (len == 11 && strncmp(str, "unavailable", 11) == 0)
+    return SWITCH_STATE_UNAVAILABLE;
+  return SWITCH_STATE_UNKNOWN;
+}
+
+const char *SwitchStore::state_name(SwitchState state) {
+  switch (state) {
+    case SWITCH_STATE_ON:
+      return "on";
+    case SWITCH_STATE_OFF:
+      return "off";
+    case SWITCH_STATE_UNAVAILABLE:
+      return "unavailable";
+    default:
+      return "unknown";
+  }
+}
+
+SwitchInfo SwitchStore::get_info(int index) const {
+  const SwitchRecord &record = this->switches_[index];
+  auto reading = [](float value) {
+    if (std::isnan(value))
+      return std::string("NA");
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%g", value);
+    return std::string(buf);
+  };
+  SwitchInfo info;
+  info.raum = this->text(record.raum);
+  info.name = this->text(record.name);
+  info.entity_id = this->text(record.entity_id);
+  info.state = state_name(record.state);
+  info.watt = reading(record.watt);
+  info.ampere = reading(record.ampere);
+  info.volt = reading(record.volt);
+  info.kwh = reading(record.kwh);
+  info.shared = record.shared ? "yes" : "no";
+  info.device = this->text(record.device);
+  info.dev_id = this->text(record.dev_id);
+  return info;
+}
+
+float SwitchStore::parse_reading(const char *str, size_t len) {
+  // strtof needs a terminated string; readings are short
+  char buf[24];
+  len = std::min(len, sizeof(buf) - 1);
+  memcpy(buf, str, len);
+  buf[len] = '\0';
+  char *end = nullptr;
+  const float value = strtof(buf, &end);
+  return end == buf ? NAN : value;
+}
+
+uint16_t SwitchStore::intern_room_(uint32_t raum) {
+  uint16_t room = this->by_room_.get(raum);
+  if (room == SWITCH_STORE_NONE) {
+    room = this->rooms_.size();
+    this->rooms_.push_back(RoomInfo{raum, SWITCH_STORE_NONE, SWITCH_STORE_NONE, 0});
+    this->by_room_.put(raum, room);
+  }
+  return room;
+}
+
+void SwitchStore::link_to_room_(uint16_t index, uint32_t raum) {
+  // Appended, so a room lists its switches in the order they were sent
+  const uint16_t room = this->intern_room_(raum);
+  RoomInfo &room_info = this->rooms_[room];
+  SwitchRecord &record = this->switches_[index];
+  record.raum = raum;
+  record.room = room;
+  record.next_in_room = SWITCH_STORE_NONE;
+  if (room_info.last == SWITCH_STORE_NONE) {
+    room_info.first = index;
+  } else {
+    this->switches_[room_info.last].next_in_room = index;
+  }
+  room_info.last = index;
+  room_info.count++;
+}
+
+void SwitchStore::unlink_from_room_(uint16_t index) {
+  SwitchRecord &record = this->switches_[index];
+  RoomInfo &room_info = this->rooms_[record.room];
+  uint16_t prev = SWITCH_STORE_NONE;
+  for (uint16_t i = room_info.first; i != index; i = this->switches_[i].next_in_room)
+    prev = i;
+  if (prev == SWITCH_STORE_NONE) {
+    room_info.first = record.next_in_room;
+  } else {
+    this->switches_[prev].next_in_room = record.next_in_room;
+  }
+  if (room_info.last == index)
+    room_info.last = prev;
+  room_info.count--;
+  record.room = SWITCH_STORE_NONE;
+}
+
+void SwitchStore::mark_changed_(uint16_t index, uint16_t fields) {
+  if (fields == 0)
+    return;
+  SwitchRecord &record = this->switches_[index];
+  record.dirty |= fields;
+  record.version = ++this->version_;
+  this->schedule_snapshot_(fields);
+  this->switch_changed_callback_.call(index, fields);
+}
+
+void SwitchStore::schedule_snapshot_(uint16_t fields) {
+  // Readings change all the time and are only saved along with the other fields, to spare the flash
+  if (!this->snapshot_ || this->snapshot_pending_ || (fields & ~SWITCH_FIELDS_READINGS) == 0)
+    return;
+  this->snapshot_pending_ = true;
+  this->set_timeout("snapshot", SNAPSHOT_DELAY_MS, [this]() { this->save_snapshot(); });
+}
+
+static bool same_reading(float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+
+uint16_t SwitchStore::upsert(const SwitchInfo &info) {
+  return this->upsert(SwitchView{info.raum, info.name, info.entity_id, info.state, info.watt, info.ampere, info.volt,
+                                 info.kwh, info.shared, info.device, info.dev_id});
+}
+
+uint16_t SwitchStore::upsert(const SwitchView &view) {
+  const uint32_t entity_id = this->strings_.intern(view.entity_id.data, view.entity_id.size);
+  const uint32_t raum = this->strings_.intern(view.raum.data, view.raum.size);
+  if (entity_id == UINT32_MAX)
+    return SWITCH_STORE_NONE;
+  uint16_t index = this->by_entity_.get(entity_id);
+  uint16_t changed = 0;
+
+  if (index == SWITCH_STORE_NONE) {
+    index = this->switches_.size();
+    SwitchRecord record{};
+    record.entity_id = entity_id;
+    record.watt = record.ampere = record.volt = record.kwh = NAN;
+    this->switches_.push_back(record);
+    this->by_entity_.put(entity_id, index);
+    this->link_to_room_(index, raum);
+    changed = SWITCH_FIELD_ADDED;
+  } else if (this->switches_[index].raum != raum) {
+    this->unlink_from_room_(index);
+    this->link_to_room_(index, raum);
+    changed |= SWITCH_FIELD_ROOM;
+  }
+
+  SwitchRecord &record = this->switches_[index];
+  record.seen = this->sync_generation_;
+
+  const uint32_t name = this->strings_.intern(view.name.data, view.name.size);
+  if (record.name != name) {
+    record.name = name;
+    changed |= SWITCH_FIELD_NAME;
+  }
+  const uint32_t device = this->strings_.intern(view.device.data, view.device.size);
+  const uint32_t dev_id = this->strings_.intern(view.dev_id.data, view.dev_id.size);
+  const bool shared = view.shared == "yes";
+  if (record.device != device || record.dev_id != dev_id || record.shared != shared) {
+    record.device = device;
+    record.dev_id = dev_id;
+    record.shared = shared;
+    changed |= SWITCH_FIELD_DEVICE;
+  }
+  const SwitchState state = parse_state(view.state.data, view.state.size);
+  if (record.state != state) {
+    record.state = state;
+    changed |= SWITCH_FIELD_STATE;
+  }
+
+  const struct {
+    Slice text;
+    float &value;
+    SwitchField field;
+  } readings[] = {
+      {view.watt, record.watt, SWITCH_FIELD_WATT},
+      {view.ampere, record.ampere, SWITCH_FIELD_AMPERE},
+      {view.volt, record.volt, SWITCH_FIELD_VOLT},
+      {view.kwh, record.kwh, SWITCH_FIELD_KWH},
+  };
+  for (const auto &reading : readings) {
+    const float value = parse_reading(reading.text.data, reading.text.size);
+    if (!same_reading(reading.value, value)) {
+      reading.value = value;
+      changed |= reading.field;
+    }
+  }
+
+  // A new switch only reports ADDED, every field is new anyway
+  if (changed & SWITCH_FIELD_ADDED)
+    changed = SWITCH_FIELD_ADDED;
+  this->mark_changed_(index, changed);
+  return index;
+}
+
+bool SwitchStore::patch(const std::string &entity_id, SwitchField field, const std::string &value) {
+  const uint16_t index = this->index_of(entity_id);
+  if (index == SWITCH_STORE_NONE)
+    return false;
+  SwitchRecord &record = this->switches_[index];
+  bool changed = false;
+
+  switch (field) {
+    case SWITCH_FIELD_STATE: {
+      const SwitchState state = parse_state(value.data(), value.size());
+      changed = record.state != state;
+      record.state = state;
+      break;
+    }
+    case SWITCH_FIELD_WATT:
+    case SWITCH_FIELD_AMPERE:
+    case SWITCH_FIELD_VOLT:
+    case SWITCH_FIELD_KWH: {
+      float &target = field == SWITCH_FIELD_WATT     ? record.watt
+                      : field == SWITCH_FIELD_AMPERE ? record.ampere
+                      : field == SWITCH_FIELD_VOLT   ? record.volt
+                                                     : record.kwh;
+      const float reading = parse_reading(value.data(), value.size());
+      changed = !same_reading(target, reading);
+      target = reading;
+      break;
+    }
+    case SWITCH_FIELD_NAME: {
+      const uint32_t name = this->strings_.intern(value);
+      changed = record.name != name;
+      record.name = name;
+      break;
+    }
+    case SWITCH_FIELD_DEVICE: {
+      const uint32_t device = this->strings_.intern(value);
+      changed = record.device != device;
+      record.device = device;
+      break;
+    }
+    case SWITCH_FIELD_ROOM: {
+      const uint32_t raum = this->strings_.intern(value);
+      changed = record.raum != raum;
+      if (changed) {
+        this->unlink_from_room_(index);
+        this->link_to_room_(index, raum);
+      }
+      break;
+    }
+    default:
+      ESP_LOGW(TAG, "Field 0x%X can not be patched", field);
+      return false;
+  }
+
+  if (changed)
+    this->mark_changed_(index, field);
+  return true;
+}
+
+size_t SwitchStore::end_sync() {
+  this->restored_ = false;
+  std::vector<SwitchRecord> kept;
+  kept.reserve(this->switches_.size());
+  for (const SwitchRecord &record : this->switches_) {
+    if (record.seen == this->sync_generation_)
+      kept.push_back(record);
+  }
+  const size_t removed = this->switches_.size() - kept.size();
+  if (removed == 0)
+    return 0;
+
+  // Indices shift: rebuild the indices and room lists; the string pool keeps the old strings until clear()
+  this->switches_.clear();
+  this->rooms_.clear();
+  this->by_entity_.clear();
+  this->by_room_.clear();
+  for (const SwitchRecord &record : kept) {
+    const uint16_t index = this->switches_.size();
+    this->switches_.push_back(record);
+    this->by_entity_.put(record.entity_id, index);
+    this->link_to_room_(index, record.raum);
+  }
+  this->version_++;
+  this->schedule_snapshot_(SWITCH_FIELD_REMOVED);
+  this->switch_changed_callback_.call(SWITCH_STORE_NONE, SWITCH_FIELD_REMOVED);
+  return removed;
+}
+
+size_t SwitchStore::parse_payload(const char *data, size_t len) {
+  size_t parsed = 0;
+  this->begin_sync();
+  split_each(Slice(data, len), "§", [this, &parsed](Slice group) {
+    group = group.trim();
+    const size_t colon = group.find(':');
+    if (colon == std::string::npos) {
+      if (!group.empty())
+        ESP_LOGW(TAG, "Group without room: %.*s", (int) std::min<size_t>(group.size, 32), group.data);
+      return;
+    }
+    SwitchView view{};
+    view.raum = group.substr(0, colon).trim();
+    split_each(group.substr(colon + 1), ",", [this, &parsed, &view](Slice entry) {
+      Slice *fields[] = {&view.name, &view.entity_id, &view.state,  &view.watt,   &view.ampere,
+                         &view.volt, &view.kwh,       &view.shared, &view.device, &view.dev_id};
+      size_t i = 0;
+      split_each(entry.trim(), "|", [&fields, &i](Slice field) {
+        if (i < sizeof(fields) / sizeof(fields[0]))
+          *fields[i++] = field.trim();
+      });
+      for (; i < sizeof(fields) / sizeof(fields[0]); i++)
+        *fields[i] = Slice();
+      if (view.entity_id.empty())
+        return;
+      this->upsert(view);
+      parsed++;
+    });
+  });
+  const size_t removed = this->end_sync();
+  ESP_LOGD(TAG, "Payload: %u switches, %u removed", (unsigned) parsed, (unsigned) removed);
+  return parsed;
+}
+
+void SwitchStore::clear() {
+  this->switches_.clear();
+  this->rooms_.clear();
+  this->by_entity_.clear();
+  this->by_room_.clear();
+  this->strings_.clear();
+  this->version_++;
+}
+
+void SwitchStore::clear_dirty() {
+  for (SwitchRecord &record : this->switches_)
+    record.dirty = 0;
+}
+
+uint16_t SwitchStore::index_of(const std::string &entity_id) const {
+  return this->by_entity_.get(this->strings_.find(entity_id.data(), entity_id.size()));
+}
+
+uint16_t SwitchStore::room_index(const std::string &raum) const {
+  return this->by_room_.get(this->strings_.find(raum.data(), raum.size()));
+}
+
+const SwitchRecord *SwitchStore::find(const std::string &entity_id) const {
+  const uint16_t index = this->index_of(entity_id);
+  return index != SWITCH_STORE_NONE ? &this->switches_[index] : nullptr;
+}
+
+bool SwitchStore::set_state(const std::string &entity_id, const std::string &state) {
+  return this->patch(entity_id, SWITCH_FIELD_STATE, state);
+}
+
+bool SwitchStore::set_readings(const std::string &entity_id, const std::string &watt, const std::string &ampere,
+                               const std::string &volt, const std::string &kwh) {
+  const uint16_t index = this->index_of(entity_id);
+  if (index == SWITCH_STORE_NONE)
+    return false;
+  // One notification for all readings
+  SwitchRecord &record = this->switches_[index];
+  uint16_t changed = 0;
+  const float values[] = {parse_reading(watt.data(), watt.size()), parse_reading(ampere.data(), ampere.size()),
+                          parse_reading(volt.data(), volt.size()), parse_reading(kwh.data(), kwh.size())};
+  float *targets[] = {&record.watt, &record.ampere, &record.volt, &record.kwh};
+  const SwitchField fields[] = {SWITCH_FIELD_WATT, SWITCH_FIELD_AMPERE, SWITCH_FIELD_VOLT, SWITCH_FIELD_KWH};
+  for (size_t i = 0; i < 4; i++) {
+    if (!same_reading(*targets[i], values[i])) {
+      *targets[i] = values[i];
+      changed |= fields[i];
+    }
+  }
+  this->mark_changed_(index, changed);
+  return true;
+}
+
+// ---------------------------------------------------------------- Snapshot
+
+// Strings are offsets into 'strings'; readings and states are the last known ones
+struct SnapshotSwitch {
+  uint16_t raum;
+  uint16_t name;
+  uint16_t entity_id;
+  uint16_t device;
+  uint16_t dev_id;
+  uint8_t state;
+  uint8_t shared;
+  float watt;
+  float ampere;
+  float volt;
+  float kwh;
+};
+
+struct Snapshot {
+  uint32_t magic;
+  uint16_t count;
+  uint16_t string_bytes;
+  SnapshotSwitch switches[SWITCH_STORE_SNAPSHOT_SWITCHES];
+  char strings[SWITCH_STORE_SNAPSHOT_STRING_BYTES];
+};
+
+void SwitchStore::setup() {
+  if (!this->snapshot_)
+    return;
+  this->snapshot_pref_ = global_preferences->make_preference<Snapshot>(SNAPSHOT_MAGIC, true);
+  this->load_snapshot_();
+}
+
+void SwitchStore::load_snapshot_() {
+  // Several KB, so not on the stack
+  ExternalRAMAllocator<Snapshot> allocator(ExternalRAMAllocator<Snapshot>::ALLOW_FAILURE);
+  Snapshot *snapshot = allocator.allocate(1);
+  if (snapshot == nullptr)
+    return;
+  const uint32_t start = millis();
+  const bool valid = this->snapshot_pref_.load(snapshot) && snapshot->magic == SNAPSHOT_MAGIC &&
+                     snapshot->count <= SWITCH_STORE_SNAPSHOT_SWITCHES &&
+                     snapshot->string_bytes <= SWITCH_STORE_SNAPSHOT_STRING_BYTES &&
+                     (snapshot->string_bytes == 0 || snapshot->strings[snapshot->string_bytes - 1] == '\0');
+  if (valid) {
+    const char *strings = snapshot->strings;
+    const uint16_t end = snapshot->string_bytes;
+    auto slice = [strings, end](uint16_t ref) {
+      return ref < end ? Slice(strings + ref, strlen(strings + ref)) : Slice();
+    };
+    for (uint16_t i = 0; i < snapshot->count; i++) {
+      const SnapshotSwitch &entry = snapshot->switches[i];
+      SwitchView view{};
+      view.raum = slice(entry.raum);
+      view.name = slice(entry.name);
+      view.entity_id = slice(entry.entity_id);
+      view.device = slice(entry.device);
+      view.dev_id = slice(entry.dev_id);
+      view.shared = Slice(entry.shared ? "yes" : "no", entry.shared ? 3 : 2);
+      if (view.entity_id.empty())
+        continue;
+      const uint16_t index = this->upsert(view);
+      if (index == SWITCH_STORE_NONE)
+        continue;
+      // State and readings are stored as numbers, not text
+      SwitchRecord &record = this->switches_[index];
+      record.state = entry.state <= SWITCH_STATE_UNAVAILABLE ? SwitchState(entry.state) : SWITCH_STATE_UNKNOWN;
+      record.watt = entry.watt;
+      record.ampere = entry.ampere;
+      record.volt = entry.volt;
+      record.kwh = entry.kwh;
+    }
+    this->restored_ = this->count() > 0;
+    ESP_LOGD(TAG, "Restored %d switches in %u ms", this->count(), (unsigned) (millis() - start));
+  }
+  allocator.deallocate(snapshot, 1);
+  // Restoring is not a change worth saving again
+  this->cancel_timeout("snapshot");
+  this->snapshot_pending_ = false;
+}
+
+void SwitchStore::save_snapshot() {
+  this->snapshot_pending_ = false;
+  if (!this->snapshot_)
+    return;
+  ExternalRAMAllocator<Snapshot> allocator(ExternalRAMAllocator<Snapshot>::ALLOW_FAILURE);
+  Snapshot *snapshot = allocator.allocate(1);
+  if (snapshot == nullptr) {
+    ESP_LOGW(TAG, "No memory for the snapshot");
+    return;
+  }
+  memset(snapshot, 0, sizeof(Snapshot));
+  snapshot->magic = SNAPSHOT_MAGIC;
+
+  // Re-interned into a fresh pool, which drops strings of removed switches and keeps the sharing
+  StringPool strings;
+  auto keep = [this, &strings](uint32_t ref) {
+    const char *str = this->text(ref);
+    return strings.intern(str, strlen(str));
+  };
+  for (const SwitchRecord &record : this->switches_) {
+    if (snapshot->count == SWITCH_STORE_SNAPSHOT_SWITCHES)
+      break;
+    SnapshotSwitch &entry = snapshot->switches[snapshot->count];
+    entry.raum = keep(record.raum);
+    entry.name = keep(record.name);
+    entry.entity_id = keep(record.entity_id);
+    entry.device = keep(record.device);
+    entry.dev_id = keep(record.dev_id);
+    // Strings of the switch that no longer fit are past string_bytes and not copied
+    if (strings.bytes() > SWITCH_STORE_SNAPSHOT_STRING_BYTES)
+      break;
+    entry.state = record.state;
+    entry.shared = record.shared;
+    entry.watt = record.watt;
+    entry.ampere = record.ampere;
+    entry.volt = record.volt;
+    entry.kwh = record.kwh;
+    snapshot->string_bytes = strings.bytes();
+    snapshot->count++;
+  }
+  memcpy(snapshot->strings, strings.get(0), snapshot->string_bytes);
+  if (snapshot->count < this->switches_.size()) {
+    // The rest would be missing after the next boot without Home Assistant
+    ESP_LOGE(TAG, "Snapshot holds only %u of %d switches, raise snapshot_switches / snapshot_string_bytes",
+             snapshot->count, this->count());
+  }
+
+  // Written to flash by the preferences sync, which skips unchanged data
+  if (!this->snapshot_pref_.save(snapshot))
+    ESP_LOGW(TAG, "Saving the snapshot failed");
+  allocator.deallocate(snapshot, 1);
+}
+
+void SwitchStore::dump_config() {
+  ESP_LOGCONFIG(TAG, "Switch Store:");
+  ESP_LOGCONFIG(TAG, "  Switches: %d in %u rooms", this->count(), (unsigned) this->rooms_.size());
+  ESP_LOGCONFIG(TAG, "  String Pool: %u bytes", (unsigned) this->strings_.bytes());
+  ESP_LOGCONFIG(TAG, "  Snapshot: %s (%u bytes)", YESNO(this->snapshot_), (unsigned) sizeof(Snapshot));
+}
 
 }  // namespace switch_store
-}  // namespace esphome
\ No newline at end of file
+}  // namespace esphome
@@ -1,12 +1,32 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/defines.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/preferences.h"
+#include "split_util.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
 namespace esphome {
 namespace switch_store {
 
+// Index value for "not found" / "end of list"
+static const uint16_t SWITCH_STORE_NONE = 0xFFFF;
+
+// Snapshot limits (snapshot_switches / snapshot_string_bytes); switches beyond them are kept in RAM but not
+// persisted. The defaults hold ~100 plugs with long entity_ids, about 12 KB of flash.
+#ifndef SWITCH_STORE_SNAPSHOT_SWITCH_LIMIT
+#define SWITCH_STORE_SNAPSHOT_SWITCH_LIMIT 128
+#endif
+#ifndef SWITCH_STORE_SNAPSHOT_STRING_LIMIT
+#define SWITCH_STORE_SNAPSHOT_STRING_LIMIT 8192
+#endif
+static const uint16_t SWITCH_STORE_SNAPSHOT_SWITCHES = SWITCH_STORE_SNAPSHOT_SWITCH_LIMIT;
+static const uint16_t SWITCH_STORE_SNAPSHOT_STRING_BYTES = SWITCH_STORE_SNAPSHOT_STRING_LIMIT;
+
+// Input format, one string per field as Home Assistant sends them
 struct SwitchInfo {
   std::string raum;
   std::string name;
@@ -21,36 +41,239 @@ struct SwitchInfo {
   std::string dev_id;
 };
 
+// Same fields as slices into a buffer owned by the caller, used by the payload parser
+struct SwitchView {
+  Slice raum;
+  Slice name;
+  Slice entity_id;
+  Slice state;
+  Slice watt;
+  Slice ampere;
+  Slice volt;
+  Slice kwh;
+  Slice shared;
+  Slice device;
+  Slice dev_id;
+};
+
+enum SwitchState : uint8_t {
+  SWITCH_STATE_UNKNOWN = 0,
+  SWITCH_STATE_OFF,
+  SWITCH_STATE_ON,
+  SWITCH_STATE_UNAVAILABLE,
+};
+
+// Fields of a record, as dirty bits and in change notifications
+enum SwitchField : uint16_t {
+  SWITCH_FIELD_STATE = 1 << 0,
+  SWITCH_FIELD_WATT = 1 << 1,
+  SWITCH_FIELD_AMPERE = 1 << 2,
+  SWITCH_FIELD_VOLT = 1 << 3,
+  SWITCH_FIELD_KWH = 1 << 4,
+  SWITCH_FIELD_NAME = 1 << 5,
+  SWITCH_FIELD_ROOM = 1 << 6,
+  SWITCH_FIELD_DEVICE = 1 << 7,  // device, dev_id and shared
+  SWITCH_FIELD_ADDED = 1 << 8,
+  // Switches were removed and indices changed; notified with index SWITCH_STORE_NONE
+  SWITCH_FIELD_REMOVED = 1 << 9,
+  SWITCH_FIELDS_READINGS = SWITCH_FIELD_WATT | SWITCH_FIELD_AMPERE | SWITCH_FIELD_VOLT | SWITCH_FIELD_KWH,
+};
+
+// Every distinct string is stored once, NUL-terminated, in one growing buffer and referred to by its offset.
+// Rooms, devices and "yes"/"no" repeat across many switches, so most strings are shared.
+// The buffer is an arena in PSRAM when there is one: strings are only appended and all freed by clear().
+class StringPool {
+ public:
+  StringPool() = default;
+  StringPool(const StringPool &) = delete;
+  StringPool &operator=(const StringPool &) = delete;
+  ~StringPool() { this->clear(); }
+
+  // UINT32_MAX if the arena could not grow
+  uint32_t intern(const char *str, size_t len);
+  uint32_t intern(const std::string &str) { return this->intern(str.data(), str.size()); }
+  // Reference of an already interned string, or UINT32_MAX
+  uint32_t find(const char *str, size_t len) const;
+  const char *get(uint32_t ref) const { return ref < this->size_ ? this->data_ + ref : ""; }
+  size_t bytes() const { return this->size_; }
+  void clear();
+
+ protected:
+  size_t slot_of_(const char *str, size_t len) const;
+  void grow_();
+  bool reserve_(size_t size);
+
+  char *data_{nullptr};
+  size_t size_{0};
+  size_t capacity_{0};
+  // Open addressing, offset + 1 per slot (0 = empty)
+  std::vector<uint32_t> table_;
+  size_t count_{0};
+};
+
+// Open addressing map from a StringPool reference to a record or room index
+class RefIndex {
+ public:
+  void put(uint32_t ref, uint16_t value);
+  uint16_t get(uint32_t ref) const;
+  void clear();
+
+ protected:
+  struct Slot {
+    uint32_t ref;
+    uint16_t value;
+  };
+  size_t slot_of_(uint32_t ref) const;
+  void grow_();
+
+  std::vector<Slot> slots_;
+  size_t count_{0};
+};
+
+// One switch: strings as StringPool references, readings as numbers (NAN if Home Assistant sent "NA")
+struct SwitchRecord {
+  uint32_t raum;
+  uint32_t name;
+  uint32_t entity_id;
+  uint32_t device;
+  uint32_t dev_id;
+  float watt;
+  float ampere;
+  float volt;
+  float kwh;
+  SwitchState state;
+  bool shared;
+  uint16_t room;          // index into the room list
+  uint16_t next_in_room;  // next switch of the same room, SWITCH_STORE_NONE at the end
+  uint16_t dirty;         // SwitchFields changed since the last clear_dirty()
+  uint32_t version;       // store version of the last change
+  uint32_t seen;          // sync generation of the last upsert
+};
+
+struct RoomInfo {
+  uint32_t name;
+  uint16_t first;  // first switch, SWITCH_STORE_NONE if empty
+  uint16_t last;
+  uint16_t count;
+};
+
 class SwitchStore : public Component {
  public:
-  void add_switch(const SwitchInfo &info) {
-    switches_.push_back(info);
-  }
+  void setup() override;
 
-  void clear() {
-    switches_.clear();
-  }
+  // Restore the last list from flash at boot and save it again after changes
+  void set_snapshot(bool snapshot) { this->snapshot_ = snapshot; }
+  // True from a restored snapshot until Home Assistant sends the first full list (readings may be old)
+  bool is_restored() const { return this->restored_; }
+  // Writes the list now; after changes this happens on its own a little later
+  void save_snapshot();
 
-  int count() const {
-    return switches_.size();
-  }
+  // Adds a switch, or updates the one with the same entity_id in place; returns its index.
+  // Only fields whose value differs are marked dirty and notified.
+  uint16_t upsert(const SwitchView &view);
+  uint16_t upsert(const SwitchInfo &info);
+  uint16_t add_switch(const SwitchInfo &info) { return this->upsert(info); }
 
-  const std::vector<SwitchInfo> &get_switches() const {
-    return switches_;
-  }
+  // Updates one field (a single SwitchField, SWITCH_FIELD_DEVICE sets the device name) of a known entity
+  bool patch(const std::string &entity_id, SwitchField field, const std::string &value);
+
+  // Full list refresh without clear(): upsert every switch between the two calls, end_sync() then removes
+  // the ones that were not sent and returns how many
+  void begin_sync() { this->sync_generation_++; }
+  size_t end_sync();
 
-  const SwitchInfo &get(int index) const {
-    return switches_[index];
+  // Full sync from the list Home Assistant sends, parsed in place without copying any token:
+  //   raum:entry,entry§raum:entry...
+  // where each entry is name|entity_id|state|watt|ampere|volt|kwh|shared|device|dev_id (missing trailing
+  // fields are empty). Returns the number of switches read.
+  size_t parse_payload(const char *data, size_t len);
+  size_t parse_payload(const std::string &payload) { return this->parse_payload(payload.data(), payload.size()); }
+
+  void clear();
+
+  // Incremented with every change, so a page can tell whether anything changed since it was drawn
+  uint32_t get_version() const { return this->version_; }
+  void clear_dirty(uint16_t index) { this->switches_[index].dirty = 0; }
+  void clear_dirty();
+
+  // Called with the index and the changed SwitchFields
+  void add_on_switch_changed_callback(std::function<void(uint16_t, uint16_t)> &&callback) {
+    this->switch_changed_callback_.add(std::move(callback));
   }
 
-  // ✅ NEU: Zugriff auf alle gespeicherten Switches
-  const std::vector<SwitchInfo>& get_all() const {
-    return this->switches_;
+  int count() const { return this->switches_.size(); }
+
+  const std::vector<SwitchRecord> &get_switches() const { return this->switches_; }
+  // Old name of get_switches(); records hold string references now, see text() and get_info()
+  const std::vector<SwitchRecord> &get_all() const { return this->switches_; }
+
+  const SwitchRecord &get(int index) const { return this->switches_[index]; }
+  // A record as strings, like the SwitchInfo that get()/get_all() returned before (copies every field,
+  // readings are formatted again, "NA" if unknown)
+  SwitchInfo get_info(int index) const;
+
+  // String of a record field
+  const char *text(uint32_t ref) const { return this->strings_.get(ref); }
+
+  // O(1) lookups, SWITCH_STORE_NONE if unknown
+  uint16_t index_of(const std::string &entity_id) const;
+  uint16_t room_index(const std::string &raum) const;
+  const SwitchRecord *find(const std::string &entity_id) const;
+
+  // In-place updates by entity_id, false if the entity is unknown (shorthands for patch())
+  bool set_state(const std::string &entity_id, const std::string &state);
+  bool set_readings(const std::string &entity_id, const std::string &watt, const std::string &ampere,
+                    const std::string &volt, const std::string &kwh);
+
+  const std::vector<RoomInfo> &get_rooms() const { return this->rooms_; }
+
+  // Calls f(index, record) for every switch of a room, in the order they were added
+  template<typename F> void for_each_in_room(uint16_t room, F f) const {
+    if (room >= this->rooms_.size())
+      return;
+    for (uint16_t i = this->rooms_[room].first; i != SWITCH_STORE_NONE; i = this->switches_[i].next_in_room)
+      f(i, this->switches_[i]);
   }
-  
+
+  void dump_config() override;
+
+  static SwitchState parse_state(const char *str, size_t len);
+  static const char *state_name(SwitchState state);
+  // Leading number of a reading such as "12.5W", NAN for "NA" or anything that is not a number
+  static float parse_reading(const char *str, size_t len);
+
  protected:
-  std::vector<SwitchInfo> switches_;
+  uint16_t intern_room_(uint32_t raum);
+  void link_to_room_(uint16_t index, uint32_t raum);
+  void unlink_from_room_(uint16_t index);
+  void mark_changed_(uint16_t index, uint16_t fields);
+  void load_snapshot_();
+  void schedule_snapshot_(uint16_t fields);
+
+  StringPool strings_;
+  RefIndex by_entity_;
+  RefIndex by_room_;
+  std::vector<SwitchRecord> switches_;
+  std::vector<RoomInfo> rooms_;
+  uint32_t version_{0};
+  uint32_t sync_generation_{0};
+  CallbackManager<void(uint16_t, uint16_t)> switch_changed_callback_;
+  ESPPreferenceObject snapshot_pref_;
+  bool snapshot_{true};
+  bool restored_{false};
+  bool snapshot_pending_{false};
+};
+
+// entity_id ("" after a removal), index and changed SwitchFields
+class SwitchChangedTrigger : public Trigger<std::string, int, uint16_t> {
+ public:
+  explicit SwitchChangedTrigger(SwitchStore *parent) {
+    parent->add_on_switch_changed_callback([this, parent](uint16_t index, uint16_t fields) {
+      const char *entity_id = index != SWITCH_STORE_NONE ? parent->text(parent->get(index).entity_id) : "";
+      this->trigger(entity_id, index == SWITCH_STORE_NONE ? -1 : int(index), fields);
+    });
+  }
 };
 
 }  // namespace switch_store
-}  // namespace esphome
\ No newline at end of file
+}  // namespace esphome